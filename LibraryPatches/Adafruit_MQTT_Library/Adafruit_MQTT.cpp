@@ -269,42 +269,58 @@ uint16_t Adafruit_MQTT::readFullPacket(uint8_t *buffer, uint16_t maxsize,
 
   uint16_t rlen;
 
-  // read the packet type:
-  rlen = readPacket(pbuff, 1, timeout);
-  if (rlen != 1)
+  // read the packet type and the first length byte, that every packet has, in
+  // one call. Then only the bytes of a longer length and the payload are left
+  rlen = readPacket(pbuff, 2, timeout);
+  if (rlen != 2)
     return 0;
 
   DEBUG_PRINT(F("Packet Type:\t"));
-  DEBUG_PRINTBUFFER(pbuff, rlen);
+  DEBUG_PRINTBUFFER(pbuff, 1);
   pbuff++;
 
   uint32_t value = 0;
   uint32_t multiplier = 1;
   uint8_t encodedByte;
 
-  do {
-    rlen = readPacket(pbuff, 1, timeout);
-    if (rlen != 1)
-      return 0;
+  while (true) {
     encodedByte = pbuff[0]; // save the last read val
     pbuff++;                // get ready for reading the next byte
     uint32_t intermediate = encodedByte & 0x7F;
     intermediate *= multiplier;
     value += intermediate;
     multiplier *= 128;
+    if (!(encodedByte & 0x80))
+      break;
     if (multiplier > (128UL * 128UL * 128UL)) {
       DEBUG_PRINT(F("Malformed packet len\n"));
       return 0;
     }
-  } while (encodedByte & 0x80);
+    rlen = readPacket(pbuff, 1, timeout);
+    if (rlen != 1)
+      return 0;
+  }
 
   DEBUG_PRINT(F("Packet Length:\t"));
   DEBUG_PRINTLN(value);
 
+  if (value == 0)
+    return (pbuff - buffer);
+
   // maxsize is limited to 65536 by 16-bit unsigned
   if (value > uint32_t(maxsize - (pbuff - buffer) - 1)) {
     DEBUG_PRINTLN(F("Packet too big for buffer"));
     rlen = readPacket(pbuff, (maxsize - (pbuff - buffer) - 1), timeout);
+
+    // skip the rest, so that the next packet is read from its start
+    uint8_t skipped[16];
+    uint32_t left = value - rlen;
+    while (left > 0) {
+      uint16_t slen = readPacket(skipped, (left < sizeof(skipped)) ? left : sizeof(skipped), timeout);
+      if (slen == 0)
+        break;
+      left -= slen;
+    }
   } else {
     rlen = readPacket(pbuff, value, timeout);
   }
@@ -33,6 +33,8 @@
 // Public Methods //////////////////////////////////////////////////////////////
 
 /* default implementation: may be overridden */
+/* Streams able to take a block should override it : print(String), print(char[]), */
+/* and the numbers and buffers, staged below, then go out in one call */
 size_t Print::write(const uint8_t *buffer, size_t size)
 {
   size_t n = 0;
@@ -331,13 +333,15 @@ size_t Print::printULLNumber(unsigned long long n64, uint8_t base)
     n16 = qq;
   }
 
-  size_t bytes = i;
-  for (; i > 0; i--)
-    write((char) (buf[i - 1] < 10 ?
-    '0' + buf[i - 1] :
-    'A' + buf[i - 1] - 10));
+  // buf is filled reverse : put the digits in order, then write them in one call
+  char str[64];
 
-  return bytes;
+  for (uint8_t j = 0; j < i; j++)
+    str[j] = (buf[i - 1 - j] < 10 ?
+    '0' + buf[i - 1 - j] :
+    'A' + buf[i - 1 - j] - 10);
+
+  return write(str, i);
 }
 
 size_t Print::printFloat(double number, int digits)
@@ -347,6 +351,10 @@ size_t Print::printFloat(double number, int digits)
 
   size_t n = 0;
 
+  // The number is staged in buf, and written in one call, instead of one call per digit
+  char buf[32];
+  uint8_t len = 0;
+
   if (isnan(number)) return print("nan");
   if (isinf(number)) return print("inf");
   if (number > 4294967040.0) return print ("ovf");  // constant determined empirically
@@ -355,7 +363,7 @@ size_t Print::printFloat(double number, int digits)
   // Handle negative numbers
   if (number < 0.0)
   {
-     n += print('-');
+     buf[len++] = '-';
      number = -number;
   }
 
@@ -369,52 +377,86 @@ size_t Print::printFloat(double number, int digits)
   // Extract the integer part of the number and print it
   unsigned long int_part = (unsigned long)number;
   double remainder = number - (double)int_part;
-  n += print(int_part);
+
+  // Integer part, reverse at the end of buf, then moved after the sign
+  char *str = &buf[sizeof(buf)];
+
+  do {
+    *--str = '0' + int_part % 10;
+    int_part /= 10;
+  } while(int_part);
+
+  uint8_t intLen = &buf[sizeof(buf)] - str;
+  memmove(&buf[len], str, intLen);
+  len += intLen;
 
   // Print the decimal point, but only if there are digits beyond
   if (digits > 0) {
-    n += print(".");
+    buf[len++] = '.';
   }
 
   // Extract digits from the remainder one at a time
   while (digits-- > 0)
   {
+    if (len == sizeof(buf)) {
+      n += write(buf, len);
+      len = 0;
+    }
+
     remainder *= 10.0;
     unsigned int toPrint = (unsigned int)remainder;
-    n += print(toPrint);
+    buf[len++] = '0' + toPrint;
     remainder -= toPrint;
   }
 
-  return n;
+  return n + write(buf, len);
 }
 
-size_t Print::printBuffer(uint8_t const buffer[], int len, char delim, int byteline)
+// Hex of buffer, with delim and line breaks, staged in str and written in one call per sizeof(str) bytes
+static size_t printHex(Print &p, uint8_t const buffer[], int len, char delim, int byteline, bool reverse)
 {
-  if (buffer == NULL || len == 0) return 0;
+  static const char hex[] = "0123456789ABCDEF";
+
+  char str[64];
+  uint8_t n = 0;
 
   for(int i=0; i<len; i++)
   {
-    if ( i != 0 ) print(delim);
-    if ( byteline && (i%byteline == 0) ) println();
+    // Room for delim, line break and 2 digits
+    if (n > sizeof(str) - 5) {
+      p.write(str, n);
+      n = 0;
+    }
+
+    if ( i != 0 ) str[n++] = delim;
 
-    this->printf("%02X", buffer[i]);
+    if ( byteline && (i%byteline == 0) ) {
+      str[n++] = '\r';
+      str[n++] = '\n';
+    }
+
+    uint8_t b = buffer[reverse ? len-1-i : i];
+
+    str[n++] = hex[b >> 4];
+    str[n++] = hex[b & 0x0F];
   }
 
+  p.write(str, n);
+
   return (len*3 - 1);
 }
 
-size_t Print::printBufferReverse(uint8_t const buffer[], int len, char delim, int byteline)
+size_t Print::printBuffer(uint8_t const buffer[], int len, char delim, int byteline)
 {
   if (buffer == NULL || len == 0) return 0;
 
-  for(int i=0; i<len; i++)
-  {
-    if (i != 0) print(delim);
-    if ( byteline && (i%byteline == 0) ) println();
+  return printHex(*this, buffer, len, delim, byteline, false);
+}
 
-    this->printf("%02X", buffer[len-1-i]);
-  }
+size_t Print::printBufferReverse(uint8_t const buffer[], int len, char delim, int byteline)
+{
+  if (buffer == NULL || len == 0) return 0;
 
-  return (len*3 - 1);
+  return printHex(*this, buffer, len, delim, byteline, true);
 }
 
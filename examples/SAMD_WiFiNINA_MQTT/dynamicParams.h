@@ -30,13 +30,14 @@
   char displayName    [MAX_DISPLAY_NAME_LEN + 1];
   char *pdata;
   uint8_t maxlen;
+  uint8_t type;
+  const char* options;
   } MenuItem;
 **************************************/
 
 #if USE_DYNAMIC_PARAMETERS
 
 #define AIO_SERVER_LEN       20
-#define AIO_SERVERPORT_LEN   6
 #define AIO_USERNAME_LEN     20
 #define AIO_KEY_LEN          40
 
@@ -45,7 +46,7 @@
 #define AIO_SUB_TOPIC_LEN    40
 
 char AIO_SERVER     [AIO_SERVER_LEN + 1]        = "io.adafruit.com";
-char AIO_SERVERPORT [AIO_SERVERPORT_LEN + 1]    = "1883";     //1883, or 8883 for SSL
+uint16_t AIO_SERVERPORT                         = 1883;               //1883, or 8883 for SSL
 char AIO_USERNAME   [AIO_USERNAME_LEN + 1]      = "private";
 char AIO_KEY        [AIO_KEY_LEN + 1]           = "private";
 
@@ -55,7 +56,7 @@ char AIO_SUB_TOPIC  [AIO_SUB_TOPIC_LEN + 1]     = "/feeds/LED_Control";
 MenuItem myMenuItems [] =
 {
   { "svr", "AIO_SERVER",      AIO_SERVER,     AIO_SERVER_LEN },
-  { "prt", "AIO_SERVERPORT",  AIO_SERVERPORT, AIO_SERVERPORT_LEN },
+  { "prt", "AIO_SERVERPORT",  (char *) &AIO_SERVERPORT, sizeof(AIO_SERVERPORT), WM_ITEM_UINT16 },
   { "usr", "AIO_USERNAME",    AIO_USERNAME,   AIO_USERNAME_LEN },
   { "key", "AIO_KEY",         AIO_KEY,        AIO_KEY_LEN },
   { "pub", "AIO_PUB_TOPIC",   AIO_PUB_TOPIC,  AIO_PUB_TOPIC_LEN },
@@ -46,11 +46,12 @@
 
 #include "Adafruit_MQTT.h"                //https://github.com/adafruit/Adafruit_MQTT_Library
 #include "Adafruit_MQTT_Client.h"         //https://github.com/adafruit/Adafruit_MQTT_Library
+#include <WiFiManager_NINA_Lite_MQTT.h>
 
 // Create a WiFiClient class to connect to the MQTT server
 WiFiClient *client                    = NULL;
 
-Adafruit_MQTT_Client    *mqtt         = NULL;
+WiFiNINA_MQTT_Client    *mqtt         = NULL;
 Adafruit_MQTT_Publish   *Temperature  = NULL;
 Adafruit_MQTT_Subscribe *LED_Control  = NULL;
 
@@ -95,28 +96,29 @@ void publishMQTT(void)
   }
 }
 
-void subscribeMQTT(void)
+void LED_ControlCallback(char *data, uint16_t len)
 {
-  Adafruit_MQTT_Subscribe *subscription;
+  (void) len;
 
-  MQTT_connect();
+  //Serial.print(F("\nGot: "));
+  //Serial.println(data);
 
-  while ((subscription = mqtt->readSubscription(5000)))
+  if (!strcmp(data, "ON"))
   {
-    if (subscription == LED_Control)
-    {
-      Serial.print(F("\nGot: "));
-      Serial.println((char *)LED_Control->lastread);
+    digitalWrite(LED_PIN, HIGH);
+  }
+  else
+  {
+    digitalWrite(LED_PIN, LOW);
+  }
+}
 
-      if (!strcmp((char*) LED_Control->lastread, "ON"))
-      {
-        digitalWrite(LED_PIN, HIGH);
-      }
-      else
-      {
-        digitalWrite(LED_PIN, LOW);
-      }
-    }
+// Call LED_ControlCallback() for the messages received, without waiting. In each loop(), for no delay
+void subscribeMQTT(void)
+{
+  if (mqtt && mqtt->connected())
+  {
+    mqtt->processPackets(0);
   }
 }
 
@@ -133,7 +135,6 @@ void check_status()
     {
       // MQTT related jobs
       publishMQTT();
-      subscribeMQTT();
     }
 
     heartBeatPrint();
@@ -184,7 +185,7 @@ void createNewInstances(void)
   if (!mqtt)
   {
     // Setup the MQTT client class by passing in the WiFi client and MQTT server and login details.
-    mqtt = new Adafruit_MQTT_Client(client, AIO_SERVER, atoi(AIO_SERVERPORT), AIO_USERNAME, AIO_KEY);
+    mqtt = new WiFiNINA_MQTT_Client(client, AIO_SERVER, AIO_SERVERPORT, AIO_USERNAME, AIO_KEY);
 
     if (mqtt)
     {
@@ -236,6 +237,7 @@ void createNewInstances(void)
       Serial.println("Creating new LED_Control object OK");
       Serial.println(String("LED_Control AIO_SUB_TOPIC = ")  + completeSubTopic);
 
+      LED_Control->setCallback(LED_ControlCallback);
       mqtt->subscribe(LED_Control);
     }
     else
@@ -370,6 +372,7 @@ void loop()
 {
   WiFiManager_NINA->run();
   check_status();
+  subscribeMQTT();
 
 #if USE_DYNAMIC_PARAMETERS
   displayCredentialsInLoop();
@@ -30,6 +30,8 @@
   char displayName    [MAX_DISPLAY_NAME_LEN + 1];
   char *pdata;
   uint8_t maxlen;
+  uint8_t type;
+  const char* options;
   } MenuItem;
 **************************************/
 
@@ -8,7 +8,7 @@
 
   Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
   Licensed under MIT license
-  Version: 1.4.1
+  Version: 1.5.0
 
   Version Modified By   Date        Comments
   ------- -----------  ----------   -----------
@@ -29,6 +29,7 @@
   1.3.1   K Hoang      15/05/2021  Fix createHTML bug.
   1.4.0   K Hoang      28/05/2021  Add support to Nano_RP2040_Connect, RASPBERRY_PI_PICO using Arduino mbed or Arduino-pico core
   1.4.1   K Hoang      12/10/2021 Update `platform.ini` and `library.json`
+  1.5.0   K Hoang      19/10/2026  Add optional storage, Config Portal, reconnect, MQTT and power features. See changelog
   **********************************************************************************************************************************/
 
 #ifndef WiFiManager_NINA_Lite_h
@@ -42,11 +43,17 @@
   #error This code is intended to run on the AVR Mega, Mega2560, Mega ADK platform! Please check your Tools->Board setting.
 #endif
 
-#define WIFIMANAGER_NINA_LITE_VERSION        "WiFiManager_NINA_Lite v1.4.1"
+#define WIFIMANAGER_NINA_LITE_VERSION        "WiFiManager_NINA_Lite v1.5.0"
 
 #include <WiFiWebServer.h>
 #include <EEPROM.h>
 #include <WiFiManager_NINA_Lite_Debug.h>
+#include <WiFiManager_NINA_Lite_PortalServer.h>
+#include <WiFiManager_NINA_Lite_DNSServer.h>
+#include <WiFiManager_NINA_Lite_Backoff.h>
+#include <WiFiManager_NINA_Lite_Service.h>
+#include <WiFiManager_NINA_Lite_Scheduler.h>
+#include <WiFiManager_NINA_Lite_Power.h>
 
 #ifndef USING_CUSTOMS_STYLE
   #define USING_CUSTOMS_STYLE     false
@@ -70,7 +77,11 @@
 #define DRD_GENERIC_DEBUG     false
 #endif
 
-#include <DoubleResetDetector_Generic.h>      //https://github.com/khoih-prog/DoubleResetDetector_Generic
+#include <WiFiManager_NINA_Lite_NoInit.h>
+
+#if !USE_NOINIT_RAM_FLAGS
+  #include <DoubleResetDetector_Generic.h>      //https://github.com/khoih-prog/DoubleResetDetector_Generic
+#endif
 
 // Number of seconds after reset during which a
 // subseqent reset will be considered a double reset.
@@ -79,7 +90,11 @@
 // RTC Memory Address for the DoubleResetDetector_Generic to use
 #define DRD_ADDRESS 0
 
-DoubleResetDetector_Generic* drd;
+#if USE_NOINIT_RAM_FLAGS
+  WiFiNINA_NoInitDRD* drd;
+#else
+  DoubleResetDetector_Generic* drd;
+#endif
 
 ///////// NEW for DRD /////////////
 
@@ -94,7 +109,12 @@ typedef struct
   char displayName    [MAX_DISPLAY_NAME_LEN + 1];
   char *pdata;
   uint8_t maxlen;
+  uint8_t type;               // New from v1.5.0. WM_ITEM_TEXT (default) or a typed item
+  const char* options;        // New from v1.5.0. Names for WM_ITEM_ENUM, such as "off|low|high"
 } MenuItem;
+
+#include <WiFiManager_NINA_Lite_MenuItem.h>
+#include <WiFiManager_NINA_Lite_StaticIP.h>
 //
 
 #if USE_DYNAMIC_PARAMETERS
@@ -103,6 +123,8 @@ typedef struct
   extern uint16_t NUM_MENU_ITEMS;
   extern MenuItem myMenuItems [];
   bool *menuItemUpdated = NULL;
+  // New from v1.5.0. Positions of myMenuItems sorted by id, for Config Portal key lookup
+  uint16_t *menuItemIndex = NULL;
 #else
   #warning Not using Dynamic Parameters
 #endif
@@ -120,7 +142,7 @@ typedef struct
 #define NUM_WIFI_CREDENTIALS      2
 
 // Configurable items besides fixed Header
-#define NUM_CONFIGURABLE_ITEMS    ( ( 2 * NUM_WIFI_CREDENTIALS ) + 1 )
+#define NUM_CONFIGURABLE_ITEMS    ( ( 2 * NUM_WIFI_CREDENTIALS ) + 1 + WM_NUM_STATIC_IP_ITEMS )
 ////////////////
 
 #define HEADER_MAX_LEN            16
@@ -131,6 +153,12 @@ typedef struct Configuration
   char header         [HEADER_MAX_LEN];
   WiFi_Credentials  WiFi_Creds  [NUM_WIFI_CREDENTIALS];
   char board_name     [BOARD_NAME_MAX_LEN];
+#if USE_STATIC_IP_CONFIG
+  WiFiNINA_IPConfig   staticIP;     // New from v1.5.0
+#endif
+#if USE_STICKY_DHCP
+  WiFiNINA_DHCPLease  dhcpLease;    // New from v1.5.0
+#endif
   int  checkSum;
 } WiFiNINA_Configuration;
 
@@ -141,6 +169,17 @@ uint16_t CONFIG_DATA_SIZE = sizeof(WiFiNINA_Configuration);
 extern bool LOAD_DEFAULT_CONFIG_DATA;
 extern WiFiNINA_Configuration defaultConfig;
 
+#include <WiFiManager_NINA_Lite_Storage.h>
+#include <WiFiManager_NINA_Lite_Json.h>
+#include <WiFiManager_NINA_Lite_SerialConfig.h>
+
+// -- HTML page fragments
+
+const char WIFININA_HTML_HEAD_START[] /*PROGMEM*/ = "<!DOCTYPE html><html><head><title>AVR_WM_NINA_Lite</title>";
+
+// New from v1.5.0. Other fragments, style and script, shared by all boards. Generated by utils/wm_html_build.py
+#include <WiFiManager_NINA_Lite_HTML.h>
+#include <WiFiManager_NINA_Lite_Page.h>
 
 //////////////////////////////////////////
 
@@ -201,6 +240,14 @@ class WiFiManager_NINA_Lite
 
     ~WiFiManager_NINA_Lite()
     {
+#if USE_CAPTIVE_PORTAL_DNS
+      if (dnsServer)
+      {
+        dnsServer->stop();
+        delete dnsServer;
+      }
+#endif
+
       if (server)
         delete server;
     }
@@ -256,10 +303,22 @@ class WiFiManager_NINA_Lite
       }
       
       WN_LOGERROR1(F("Hostname="), RFC952_hostname);
+
+#if USE_RECONNECT_BACKOFF
+      // New from v1.5.0. Different on each device, so that devices losing the same AP don't retry together
+      uint8_t macAddress[6];
+      
+      WiFi.macAddress(macAddress);
+      reconnectBackoff.seed(macAddress, sizeof(macAddress));
+#endif
       //////
       
       //// New DRD ////
-      drd = new DoubleResetDetector_Generic(DRD_TIMEOUT, DRD_ADDRESS);  
+#if USE_NOINIT_RAM_FLAGS
+      drd = new WiFiNINA_NoInitDRD(DRD_TIMEOUT);
+#else
+      drd = new DoubleResetDetector_Generic(DRD_TIMEOUT, DRD_ADDRESS);
+#endif
       bool noConfigPortal = true;
    
       if (drd->detectDoubleReset())
@@ -340,6 +399,18 @@ class WiFiManager_NINA_Lite
   #define RESET_IF_CONFIG_TIMEOUT   true
 #endif
 
+// New from v1.5.0
+// After Save in Config Portal, stop Config Portal AP and connect with the new Config Data, instead of delay then reset.
+// Reset only if no WiFi can be connected
+#ifndef USE_LIVE_RECONFIG
+  #define USE_LIVE_RECONFIG         false
+#endif
+
+#ifndef WM_LIVE_RECONFIG_DELAY
+  // ms. Config Portal keeps serving for this time after Save, so that the last responses go out
+  #define WM_LIVE_RECONFIG_DELAY    200L
+#endif
+
 #ifndef CONFIG_TIMEOUT_RETRYTIMES_BEFORE_RESET
   #define CONFIG_TIMEOUT_RETRYTIMES_BEFORE_RESET          10
 #else
@@ -373,12 +444,40 @@ class WiFiManager_NINA_Lite
       // consider the next reset as a double reset.
       drd->loop();
       //// New DRD ////
+
+#if USE_STICKY_DHCP
+      // New from v1.5.0. Lease kept or dropped by connectMultiWiFi(). Not while Config Portal may be changing Config Data
+      if (leaseChanged && !configuration_mode)
+      {
+        leaseChanged = false;
+        saveConfigData();
+      }
+#endif
+
+#if USE_SERIAL_CONFIG
+      // New from v1.5.0. Requests of a provisioning host, in both normal and Config Portal mode
+      handleSerialConfig();
+#endif
+
+#if USE_LIVE_RECONFIG
+      // New from v1.5.0. Config Data saved in Config Portal
+      if ( reconfigurePending && (millis() - reconfigureTime >= WM_LIVE_RECONFIG_DELAY) )
+      {
+        reconfigure();
+
+        return;
+      }
+#endif
          
       if ( !configuration_mode && (millis() > checkstatus_timeout) )
       {       
         if (WiFi.status() == WL_CONNECTED)
         {
           wifi_connected = true;
+
+#if USE_RECONNECT_BACKOFF
+          reconnectBackoff.succeeded();
+#endif
         }
         else
         {
@@ -395,8 +494,22 @@ class WiFiManager_NINA_Lite
         }
         
         checkstatus_timeout = millis() + WIFI_STATUS_CHECK_INTERVAL;
+
+#if USE_LOW_POWER_IDLE
+        nextStatusCheck = checkstatus_timeout;
+#endif
       }    
 
+#if USE_RUN_SERVICES
+      // New from v1.5.0. Services added by addService(), such as the MQTT session
+      runServices();
+#endif
+
+#if USE_TASK_SCHEDULER
+      // New from v1.5.0. Tasks added by addTask(), in both normal and Config Portal mode
+      scheduler.runTasks(WM_TASK_TIME_SLICE);
+#endif
+
       // Lost connection in running. Give chance to reconfig.
       if ( !wifi_connected )
       {
@@ -411,11 +524,24 @@ class WiFiManager_NINA_Lite
             //WN_LOGDEBUG(F("r:handleClient"));
             server->handleClient();
           }
+
+#if USE_CAPTIVE_PORTAL_DNS
+          if (dnsServer)
+          {
+            dnsServer->processRequests();
+          }
+#endif
            
           return;
         }
         else
         {
+#if USE_RECONNECT_BACKOFF
+          // New from v1.5.0. Only at the scheduled time, not in every run()
+          if ( !reconnectBackoff.due(millis()) )
+            return;
+#endif
+
 #if RESET_IF_CONFIG_TIMEOUT
           // If we're here but still in configuration_mode, permit running TIMES_BEFORE_RESET times before reset hardware
           // to permit user another chance to config.
@@ -440,7 +566,19 @@ class WiFiManager_NINA_Lite
             if (connectMultiWiFi(RETRY_TIMES_RECONNECT_WIFI))
             {
               WN_LOGERROR(F("r:WOK"));
+
+#if USE_RECONNECT_BACKOFF
+              reconnectBackoff.succeeded();
+#endif
+            }
+#if USE_RECONNECT_BACKOFF
+            else
+            {
+              reconnectBackoff.failed(millis());
+              
+              WN_LOGERROR3(F("r:NextReconW="), reconnectBackoff.getDelay(), F(",Try#"), reconnectBackoff.getAttempts());
             }
+#endif
           }
         }
       }
@@ -504,6 +642,18 @@ class WiFiManager_NINA_Lite
     {
       static_IP = ip;
     }
+
+    //////////////////////////////////////////////
+
+    // New from v1.5.0
+    void setSTAStaticIPConfig(IPAddress ip, IPAddress gw, IPAddress sn = IPAddress(255, 255, 255, 0),
+                              IPAddress dns = IPAddress(0, 0, 0, 0))
+    {
+      static_IP   = ip;
+      static_GW   = gw;
+      static_SN   = sn;
+      static_DNS  = dns;
+    }
     
     //////////////////////////////////////////////
     
@@ -570,8 +720,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS      
       for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
       {
-        // Actual size of pdata is [maxlen + 1]
-        memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+        WiFiNINA_clearMenuItem(myMenuItems[i]);
       }
 #endif
 
@@ -586,6 +735,157 @@ class WiFiManager_NINA_Lite
     }
     
     //////////////////////////////////////////////
+
+#if USE_RECONNECT_BACKOFF
+    // New from v1.5.0. Min and max wait between reconnect tries after WiFi is lost, in ms
+    void setReconnectBackoff(unsigned long baseDelay, unsigned long maxDelay)
+    {
+      reconnectBackoff.setDelays(baseDelay, maxDelay);
+    }
+    
+    //////////////////////////////////////////////
+    
+    // getAttempts(), getDelay() and getTimeToNextAttempt(millis()) of the reconnect scheduler
+    const WiFiNINA_Backoff& getReconnectBackoff()
+    {
+      return reconnectBackoff;
+    }
+    
+    //////////////////////////////////////////////
+#endif
+
+#if USE_RUN_SERVICES
+    // New from v1.5.0. Run service in each run(), up to WM_MAX_SERVICES
+    bool addService(WiFiNINA_Service* service)
+    {
+      if (numServices >= WM_MAX_SERVICES)
+        return false;
+
+      services[numServices++] = service;
+
+      return true;
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_TASK_SCHEDULER
+    // New from v1.5.0. Run function every period ms from run(), up to WM_MAX_TASKS. Return the task, or -1
+    int8_t addTask(WiFiNINA_TaskFunction function, unsigned long period, unsigned long deadline = 0,
+                   unsigned long budget = 0)
+    {
+      return scheduler.addTask(function, period, deadline, budget);
+    }
+
+    // setTaskEnabled(), and taskStats() with runs, overruns, missed and skipped of each task
+    WiFiNINA_Scheduler& getScheduler()
+    {
+      return scheduler;
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_LOW_POWER_IDLE
+    // New from v1.5.0
+    // ms until run() has something to do, at most WM_IDLE_MAX_SLEEP, or WM_IDLE_POLL_INTERVAL if it polls
+    unsigned long getTimeToNextEvent()
+    {
+      unsigned long now   = millis();
+      unsigned long wait  = WM_IDLE_MAX_SLEEP;
+
+      if (configuration_mode)
+      {
+        // Config Portal
+        wait = WM_IDLE_POLL_INTERVAL;
+      }
+      else
+      {
+        if ( (long) (nextStatusCheck - now) < 0 )
+          return 0;
+
+        if (nextStatusCheck - now + 1 < wait)
+          wait = nextStatusCheck - now + 1;
+
+        if (!wifi_connected)
+        {
+#if USE_RECONNECT_BACKOFF
+          if (reconnectBackoff.getTimeToNextAttempt(now) < wait)
+            wait = reconnectBackoff.getTimeToNextAttempt(now);
+#else
+          // Reconnect in each run()
+          return 0;
+#endif
+        }
+      }
+
+#if USE_LIVE_RECONFIG
+      if (reconfigurePending)
+      {
+        if (now - reconfigureTime >= WM_LIVE_RECONFIG_DELAY)
+          return 0;
+
+        if (WM_LIVE_RECONFIG_DELAY - (now - reconfigureTime) < wait)
+          wait = WM_LIVE_RECONFIG_DELAY - (now - reconfigureTime);
+      }
+#endif
+
+#if USE_RUN_SERVICES
+      if ( (numServices > 0) && (wait > WM_IDLE_POLL_INTERVAL) )
+        wait = WM_IDLE_POLL_INTERVAL;
+#endif
+
+#if USE_TASK_SCHEDULER
+      wait = scheduler.getTimeToNextTask(now, wait);
+#endif
+
+      return wait;
+    }
+
+    // Idle the MCU until run() has something to do. Call after run() in loop()
+    void sleepUntilNextEvent()
+    {
+      unsigned long wait = getTimeToNextEvent();
+
+      if (wait == 0)
+        return;
+
+      unsigned long startTime = millis();
+
+      WiFiNINA_idle(wait);
+
+      powerStats.sleeps++;
+      powerStats.idleTime += millis() - startTime;
+    }
+
+    // Idle time against millis() - startTime, the duty cycle to estimate the energy used
+    const WiFiNINA_PowerStats& getPowerStats()
+    {
+      return powerStats;
+    }
+
+    void resetPowerStats()
+    {
+      powerStats.sleeps     = 0;
+      powerStats.idleTime   = 0;
+      powerStats.startTime  = millis();
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+    // New from v1.5.0. As WM_WIFI_POWER_SAVE, now and after each WiFi connection
+    void setWiFiPowerSave(bool enable)
+    {
+      wifiPowerSave = enable;
+
+      if (enable)
+        WiFi.lowPowerMode();
+      else
+        WiFi.noLowPowerMode();
+    }
+
+    //////////////////////////////////////////////
     
     // Forced CP => Flag = 0xBEEFBEEF. Else => No forced CP
     // Flag to be stored at (EEPROM_START + DRD_FLAG_DATA_SIZE + CONFIG_DATA_SIZE) 
@@ -691,9 +991,63 @@ class WiFiManager_NINA_Lite
   private:
     String ipAddress = "0.0.0.0";
 
-    WiFiWebServer* server = NULL;
+    WiFiNINA_WebServer* server = NULL;
+
+#if USE_CAPTIVE_PORTAL_DNS
+    // New from v1.5.0
+    WiFiNINA_DNSServer* dnsServer = NULL;
+#endif
+
+#if USE_SERIAL_CONFIG
+    // New from v1.5.0
+    WiFiNINA_SerialConfig serialConfig;
+#endif
+
+#if USE_RECONNECT_BACKOFF
+    // New from v1.5.0
+    WiFiNINA_Backoff reconnectBackoff;
+#endif
+
+#if USE_RUN_SERVICES
+    // New from v1.5.0
+    WiFiNINA_Service* services[WM_MAX_SERVICES];
+    uint8_t           numServices = 0;
+#endif
+
+#if USE_TASK_SCHEDULER
+    // New from v1.5.0
+    WiFiNINA_Scheduler scheduler;
+#endif
+
+#if USE_LOW_POWER_IDLE
+    // New from v1.5.0
+    WiFiNINA_PowerStats powerStats      = { 0, 0, 0 };
+    unsigned long       nextStatusCheck = 0;
+#endif
+
+    // New from v1.5.0
+    bool wifiPowerSave = WM_WIFI_POWER_SAVE;
     bool configuration_mode = false;
 
+    // Config Portal items received since the last save
+    int  number_items_Updated = 0;
+    bool id_Updated           = false;
+    bool pw_Updated           = false;
+    bool id1_Updated          = false;
+    bool pw1_Updated          = false;
+    bool nm_Updated           = false;
+
+#if USE_STATIC_IP_CONFIG
+    // One bit per ip, gw, sn, dns
+    uint8_t ip_Updated        = 0;
+#endif
+
+#if USE_LIVE_RECONFIG
+    // New from v1.5.0
+    bool          reconfigurePending  = false;
+    unsigned long reconfigureTime     = 0;
+#endif
+
     unsigned long configTimeout;
     bool hadConfigData = false;
     
@@ -714,6 +1068,16 @@ class WiFiManager_NINA_Lite
     String portal_pass = "";
 
     IPAddress static_IP   = IPAddress(0, 0, 0, 0);
+    IPAddress static_GW   = IPAddress(0, 0, 0, 0);
+    IPAddress static_SN   = IPAddress(0, 0, 0, 0);
+    IPAddress static_DNS  = IPAddress(0, 0, 0, 0);
+
+#if USE_STICKY_DHCP
+    // The module keeps a reused lease as static IP config until WiFi.end()
+    bool leaseApplied = false;
+    // Lease to be written by run()
+    bool leaseChanged = false;
+#endif
     
     /////////////////////////////////////
     
@@ -769,7 +1133,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS     
       for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
       {
-        WN_LOGERROR5("i=", i, ",id=", myMenuItems[i].id, ",data=", myMenuItems[i].pdata);
+        WN_LOGERROR5("i=", i, ",id=", myMenuItems[i].id, ",data=", WiFiNINA_menuItemToString(myMenuItems[i]));
       }
 #endif               
     }
@@ -810,6 +1174,14 @@ class WiFiManager_NINA_Lite
 // Stating positon to store Blynk8266_WM_config
 #define CONFIG_EEPROM_START    (EEPROM_START + DRD_FLAG_DATA_SIZE)
 
+#if USE_CONFIG_AB_SLOTS
+  // New from v1.5.0. Layout is [DRD flag][Forced CP flag][Slot 0][Slot 1]
+  #define FORCED_CP_EEPROM_START    (CONFIG_EEPROM_START)
+  #define SLOT_EEPROM_START         (CONFIG_EEPROM_START + FORCED_CONFIG_PORTAL_FLAG_DATA_SIZE)
+#else
+  #define FORCED_CP_EEPROM_START    (CONFIG_EEPROM_START + CONFIG_DATA_SIZE)
+#endif
+
     int calcChecksum()
     {
       int checkSum = 0;
@@ -829,14 +1201,38 @@ class WiFiManager_NINA_Lite
     
       WN_LOGERROR(isPersistent ? F("setForcedCP Persistent") : F("setForcedCP non-Persistent"));
 
-      EEPROM.put(CONFIG_EEPROM_START + CONFIG_DATA_SIZE, readForcedConfigPortalFlag);      
+#if USE_NOINIT_RAM_FLAGS
+      // New from v1.5.0. Only the persistent flag has to survive a power cycle
+      if (!isPersistent)
+      {
+        WiFiNINA_setNoInitForcedCP(readForcedConfigPortalFlag);
+        return;
+      }
+#endif
+
+      EEPROM.put(FORCED_CP_EEPROM_START, readForcedConfigPortalFlag);      
     }
     
     //////////////////////////////////////////////
     
     void clearForcedCP()
     {
-      EEPROM.put(CONFIG_EEPROM_START + CONFIG_DATA_SIZE, 0);     
+#if USE_NOINIT_RAM_FLAGS
+      WiFiNINA_setNoInitForcedCP(0);
+      
+      // Write to storage only if a (persistent) flag is stored there
+      bool persistent   = persForcedConfigPortal;
+      bool storedFlag   = isForcedCP();
+      
+      persForcedConfigPortal = persistent;
+      
+      if (!storedFlag)
+      {
+        return;
+      }
+#endif
+
+      EEPROM.put(FORCED_CP_EEPROM_START, 0);     
     }
     
     //////////////////////////////////////////////
@@ -845,9 +1241,18 @@ class WiFiManager_NINA_Lite
     {
       uint32_t readForcedConfigPortalFlag;
 
+#if USE_NOINIT_RAM_FLAGS
+      // New from v1.5.0. Non-persistent forced CP is kept in no-init RAM
+      if (WiFiNINA_getNoInitForcedCP() == FORCED_CONFIG_PORTAL_FLAG_DATA)
+      {
+        persForcedConfigPortal = false;
+        return true;
+      }
+#endif
+
       // Return true if forced CP (0xDEADBEEF read at offset EPROM_START + DRD_FLAG_DATA_SIZE + CONFIG_DATA_SIZE)
       // => set flag noForcedConfigPortal = false
-      EEPROM.get(CONFIG_EEPROM_START + CONFIG_DATA_SIZE, readForcedConfigPortalFlag);
+      EEPROM.get(FORCED_CP_EEPROM_START, readForcedConfigPortalFlag);
      
       // Return true if forced CP (0xDEADBEEF read at offset EPROM_START + DRD_FLAG_DATA_SIZE + CONFIG_DATA_SIZE)
       // => set flag noForcedConfigPortal = false     
@@ -944,8 +1349,7 @@ class WiFiManager_NINA_Lite
         char* _pointer = myMenuItems[i].pdata;
         totalDataSize += myMenuItems[i].maxlen;
         
-        // Actual size of pdata is [maxlen + 1]
-        memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+        WiFiNINA_clearMenuItem(myMenuItems[i]);
                
         for (uint16_t j = 0; j < myMenuItems[i].maxlen; j++,_pointer++,offset++)
         {
@@ -1053,75 +1457,236 @@ class WiFiManager_NINA_Lite
     
     //////////////////////////////////////////////
     
-    bool EEPROM_get()
-    {      
-      EEPROM.get(CONFIG_EEPROM_START, WIFININA_config);
-      
-      NULLTerminateConfig();
-      
-      return isWiFiConfigValid();
-    }
+#if USE_CONFIG_AB_SLOTS
+
+    // New from v1.5.0
+    uint8_t   activeSlot        = 0;
+    uint32_t  activeGeneration  = 0;
     
     //////////////////////////////////////////////
     
-    void EEPROM_put()
-    {
-      EEPROM.put(CONFIG_EEPROM_START, WIFININA_config);
-    }
-    
-    //////////////////////////////////////////////
-
-    void saveConfigData()
+    uint16_t slotOffset(uint8_t slot)
     {
-      int calChecksum = calcChecksum();
-      WIFININA_config.checkSum = calChecksum;
-      
-      WN_LOGERROR5(F("SaveEEPROM,Sz="), EEPROM.length(), F(",DataSz="), totalDataSize, F(",CSum=0x"), String(calChecksum, HEX));
-
-      EEPROM_put();
+      // 4-byte aligned slots of header + data
+      uint16_t slotSize = ( sizeof(WiFiNINA_SlotHeader) + WiFiNINA_slotDataSize() + 3 ) & ~3;
       
-#if USE_DYNAMIC_PARAMETERS        
-      EEPROM_putDynamicData();
-#endif
+      return SLOT_EEPROM_START + ( slot * slotSize );
     }
     
     //////////////////////////////////////////////
     
-    // New from v1.0.5
-    void loadAndSaveDefaultConfigData()
+    bool loadSlotData()
     {
-      // Load Default Config Data from Sketch
-      memcpy(&WIFININA_config, &defaultConfig, sizeof(WIFININA_config));
-      strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
+      WiFiNINA_SlotHeader header[WM_NUM_SLOTS];
+      uint8_t   order[WM_NUM_SLOTS];
+      uint16_t  dataSize = WiFiNINA_slotDataSize();
       
-      // Including config and dynamic data, and assume valid
-      saveConfigData();
+      // Only the slot headers are read to select the newest slot
+      for (uint8_t slot = 0; slot < WM_NUM_SLOTS; slot++)
+      {
+        EEPROM.get(slotOffset(slot), header[slot]);
+      }
+      
+      uint8_t numValidSlots = WiFiNINA_orderSlots(header, dataSize, order);
+      
+      if (numValidSlots == 0)
+      {
+        WN_LOGERROR(F("No valid Config Slot"));
+        return false;
+      }
+      
+      uint8_t* data = new uint8_t[dataSize];
+      
+      if (data == nullptr)
+      {
+        WN_LOGERROR(F("Can't alloc Slot buffer"));
+        return false;
+      }
+      
+      // Newest slot first, fall back to the older one if its data is corrupted
+      for (uint8_t i = 0; i < numValidSlots; i++)
+      {
+        uint8_t   slot    = order[i];
+        uint16_t  offset  = slotOffset(slot) + sizeof(WiFiNINA_SlotHeader);
+        
+        for (uint16_t j = 0; j < dataSize; j++, offset++)
+        {
+          data[j] = EEPROM.read(offset);
+        }
+        
+        if (WiFiNINA_crc32(data, dataSize) == header[slot].crc)
+        {
+          WiFiNINA_unpackSlotData(data, WIFININA_config);
           
-      WN_LOGERROR(F("======= Start Loaded Config Data ======="));
-      displayConfigData(WIFININA_config);    
+          activeSlot        = slot;
+          activeGeneration  = header[slot].generation;
+          totalDataSize     = dataSize;
+          
+          delete [] data;
+          
+          WN_LOGERROR3(F("LoadSlot="), slot, F(",Gen="), activeGeneration);
+          
+          return true;
+        }
+        
+        WN_LOGERROR1(F("Bad CRC, Slot="), slot);
+      }
+      
+      delete [] data;
+      
+      return false;
     }
     
     //////////////////////////////////////////////
     
-    bool getConfigData()
+    bool saveSlotData()
     {
-      bool dynamicDataValid = true;
-      int calChecksum;  
-      
-      hadConfigData = false; 
+      WiFiNINA_SlotHeader header;
+      uint16_t  dataSize = WiFiNINA_slotDataSize();
       
-      EEPROM.begin();    
+      // Always write to the inactive slot. The active one stays untouched until the new one is verified
+      uint8_t   slot    = activeSlot ^ 1;
+      uint16_t  offset  = slotOffset(slot) + sizeof(WiFiNINA_SlotHeader);
       
-      // Use new LOAD_DEFAULT_CONFIG_DATA logic
-      if (LOAD_DEFAULT_CONFIG_DATA)
-      {     
-        // Load Config Data from Sketch
-        loadAndSaveDefaultConfigData();
-        
-        // Don't need Config Portal anymore
-        return true; 
+      if (slotOffset(WM_NUM_SLOTS) > EEPROM.length())
+      {
+        WN_LOGERROR1(F("Slots too big for EEPROM, need "), slotOffset(WM_NUM_SLOTS));
+        return false;
       }
-      else
+      
+      uint8_t* data = new uint8_t[dataSize];
+      
+      if (data == nullptr)
+      {
+        WN_LOGERROR(F("Can't alloc Slot buffer"));
+        return false;
+      }
+      
+      WiFiNINA_packSlotData(data, WIFININA_config);
+      WiFiNINA_initSlotHeader(header, data, dataSize, activeGeneration + 1);
+      
+      for (uint16_t j = 0; j < dataSize; j++)
+      {
+        EEPROM.write(offset + j, data[j]);
+      }
+      
+      bool verified = true;
+      
+      for (uint16_t j = 0; j < dataSize; j++)
+      {
+        if (EEPROM.read(offset + j) != data[j])
+        {
+          verified = false;
+          break;
+        }
+      }
+      
+      delete [] data;
+      
+      if (!verified)
+      {
+        WN_LOGERROR1(F("Verify failed, Slot="), slot);
+        return false;
+      }
+      
+      // Writing the header with the newer generation last makes this slot the active one
+      EEPROM.put(slotOffset(slot), header);
+      
+      activeSlot        = slot;
+      activeGeneration  = header.generation;
+      totalDataSize     = dataSize;
+      
+      WN_LOGERROR3(F("SaveSlot="), slot, F(",Gen="), activeGeneration);
+      
+      return true;
+    }
+    
+    //////////////////////////////////////////////
+    
+#endif    // USE_CONFIG_AB_SLOTS
+
+    bool EEPROM_get()
+    {
+#if USE_CONFIG_AB_SLOTS
+      // Config and Dynamic Data are read together from the newest valid slot
+      if (!loadSlotData())
+      {
+        memset(&WIFININA_config, 0, sizeof(WIFININA_config));
+      }
+#else
+      
+      EEPROM.get(CONFIG_EEPROM_START, WIFININA_config);
+#endif
+
+      NULLTerminateConfig();
+      
+      return isWiFiConfigValid();
+    }
+    
+    //////////////////////////////////////////////
+    
+    void EEPROM_put()
+    {
+      EEPROM.put(CONFIG_EEPROM_START, WIFININA_config);
+    }
+    
+    //////////////////////////////////////////////
+
+    void saveConfigData()
+    {
+      int calChecksum = calcChecksum();
+      WIFININA_config.checkSum = calChecksum;
+      
+      WN_LOGERROR5(F("SaveEEPROM,Sz="), EEPROM.length(), F(",DataSz="), totalDataSize, F(",CSum=0x"), String(calChecksum, HEX));
+
+#if USE_CONFIG_AB_SLOTS
+      saveSlotData();
+#else
+      EEPROM_put();
+      
+  #if USE_DYNAMIC_PARAMETERS
+      EEPROM_putDynamicData();
+  #endif
+#endif
+    }
+    
+    //////////////////////////////////////////////
+    
+    // New from v1.0.5
+    void loadAndSaveDefaultConfigData()
+    {
+      // Load Default Config Data from Sketch
+      memcpy(&WIFININA_config, &defaultConfig, sizeof(WIFININA_config));
+      strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
+      
+      // Including config and dynamic data, and assume valid
+      saveConfigData();
+          
+      WN_LOGERROR(F("======= Start Loaded Config Data ======="));
+      displayConfigData(WIFININA_config);    
+    }
+    
+    //////////////////////////////////////////////
+    
+    bool getConfigData()
+    {
+      bool dynamicDataValid = true;
+      int calChecksum;  
+      
+      hadConfigData = false; 
+      
+      EEPROM.begin();    
+      
+      // Use new LOAD_DEFAULT_CONFIG_DATA logic
+      if (LOAD_DEFAULT_CONFIG_DATA)
+      {     
+        // Load Config Data from Sketch
+        loadAndSaveDefaultConfigData();
+        
+        // Don't need Config Portal anymore
+        return true; 
+      }
+      else
       {   
         // Load stored config data from EEPROM
         WN_LOGERROR1(F("EEPROMsz:"), EEPROM_SIZE);
@@ -1139,7 +1704,7 @@ class WiFiManager_NINA_Lite
         WN_LOGERROR3(F("CCSum=0x"), String(calChecksum, HEX),
                    F(",RCSum=0x"), String(WIFININA_config.checkSum, HEX));
         
-#if USE_DYNAMIC_PARAMETERS        
+#if (USE_DYNAMIC_PARAMETERS && !USE_CONFIG_AB_SLOTS)
         // Load stored dynamic data from LittleFS
         dynamicDataValid = checkDynamicData();
 #endif           
@@ -1150,7 +1715,7 @@ class WiFiManager_NINA_Lite
         {
           if (dynamicDataValid)
           {
-  #if USE_DYNAMIC_PARAMETERS        
+  #if (USE_DYNAMIC_PARAMETERS && !USE_CONFIG_AB_SLOTS)
             EEPROM_getDynamicData();
             
             WN_LOGERROR(F("Valid Stored Dynamic Data"));
@@ -1196,8 +1761,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS
           for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
           {
-            // Actual size of pdata is [maxlen + 1]
-            memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+            WiFiNINA_clearMenuItem(myMenuItems[i]);
           }
 #endif
               
@@ -1210,7 +1774,8 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS
           for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
           {
-            strncpy(myMenuItems[i].pdata, WM_NO_CONFIG, myMenuItems[i].maxlen);
+            if (myMenuItems[i].type == WM_ITEM_TEXT)
+              strncpy(myMenuItems[i].pdata, WM_NO_CONFIG, myMenuItems[i].maxlen);
           }
 #endif          
         }
@@ -1220,7 +1785,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS
         for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
         {
-          WN_LOGDEBUG3(F("g:myMenuItems["), i, F("]="), myMenuItems[i].pdata );
+          WN_LOGDEBUG3(F("g:myMenuItems["), i, F("]="), WiFiNINA_menuItemToString(myMenuItems[i]) );
         }
 #endif
         
@@ -1246,6 +1811,97 @@ class WiFiManager_NINA_Lite
        
     //////////////////////////////////////////////
 
+    // New from v1.5.0
+    // Static IP of Config Data, then of setSTAStaticIPConfig(), then the DHCP lease kept for this WiFi_Creds index.
+    // Return WM_IP_STATIC, WM_IP_LEASE or WM_IP_DHCP
+    uint8_t configIP(uint8_t index)
+    {
+#if USE_STATIC_IP_CONFIG
+      if (WiFiNINA_isIPSet(WIFININA_config.staticIP.ip))
+      {
+        WN_LOGDEBUG(F("UseCfgStatIP"));
+        WiFiNINA_configStaticIP(WIFININA_config.staticIP);
+
+        return WM_IP_STATIC;
+      }
+#endif
+
+      if (static_IP != IPAddress(0, 0, 0, 0))
+      {
+        WN_LOGDEBUG(F("UseStatIP"));
+        WiFiNINA_configStaticIP(static_IP, static_GW, static_SN, static_DNS);
+
+        return WM_IP_STATIC;
+      }
+
+#if USE_STICKY_DHCP
+      const WiFiNINA_DHCPLease& lease = WIFININA_config.dhcpLease;
+
+      if ( WiFiNINA_isIPSet(lease.ipConfig.ip) && (lease.index == index) )
+      {
+        WN_LOGDEBUG1(F("UseLease IP="), WiFiNINA_toIPAddress(lease.ipConfig.ip));
+        WiFiNINA_configStaticIP(lease.ipConfig);
+        leaseApplied = true;
+
+        return WM_IP_LEASE;
+      }
+
+      if (leaseApplied)
+      {
+        // Back to DHCP
+        WiFi.end();
+        leaseApplied = false;
+      }
+#endif
+
+      return WM_IP_DHCP;
+    }
+
+    //////////////////////////////////////////////
+
+#if USE_STICKY_DHCP
+    // New from v1.5.0
+    // After connecting with index. Keep a new DHCP lease, written by run() if changed, out of the connect path.
+    // Return false if the lease reused for index doesn't work, after dropping it
+    bool updateDHCPLease(uint8_t ipMode, uint8_t index)
+    {
+      WiFiNINA_DHCPLease& lease = WIFININA_config.dhcpLease;
+
+      if (ipMode == WM_IP_LEASE)
+      {
+        // Applied by configIP() only for its own index
+        if ( (lease.index != index) || WiFiNINA_verifyDHCPLease(lease) )
+          return true;
+
+        WN_LOGDEBUG(F("DropLease"));
+
+        memset(&lease, 0, sizeof(lease));
+        leaseChanged = true;
+
+        return false;
+      }
+
+      if (ipMode == WM_IP_DHCP)
+      {
+        WiFiNINA_DHCPLease newLease;
+
+        WiFiNINA_readDHCPLease(newLease, index);
+
+        if ( WiFiNINA_isIPSet(newLease.ipConfig.ip) && memcmp(&newLease, &lease, sizeof(lease)) )
+        {
+          WN_LOGDEBUG1(F("SaveLease IP="), WiFi.localIP());
+
+          lease         = newLease;
+          leaseChanged  = true;
+        }
+      }
+
+      return true;
+    }
+
+    //////////////////////////////////////////////
+#endif
+
     // New connection logic from v1.2.0
     bool connectMultiWiFi(int retry_time)
     {
@@ -1258,12 +1914,6 @@ class WiFiManager_NINA_Lite
 
       WN_LOGDEBUG(F("ConMultiWifi"));
       
-      if (static_IP != IPAddress(0, 0, 0, 0))
-      {
-        WN_LOGDEBUG(F("UseStatIP"));
-        WiFi.config(static_IP);
-      }
-      
       if (lastConnectedIndex != 255)
       {
         //  Successive connection, index = ??
@@ -1300,6 +1950,11 @@ class WiFiManager_NINA_Lite
         }
       } 
          
+#if USE_STICKY_DHCP
+      int     retries = retry_time;
+      uint8_t ipMode  = WM_IP_DHCP;
+#endif
+
       WN_LOGERROR3(F("con2WF:SSID="), WIFININA_config.WiFi_Creds[index].wifi_ssid,
                    F(",PW="), WIFININA_config.WiFi_Creds[index].wifi_pw);
       
@@ -1307,6 +1962,13 @@ class WiFiManager_NINA_Lite
       
       while ( !wifi_connected && (numIndexTried++ < NUM_WIFI_CREDENTIALS) )
       {         
+        // New from v1.5.0. IP config of the index tried, not of the first one
+#if USE_STICKY_DHCP
+        ipMode = configIP(index);
+#else
+        configIP(index);
+#endif
+
         while ( 0 < retry_time )
         {      
           WN_LOGDEBUG1(F("Remaining retry_time="), retry_time);
@@ -1353,9 +2015,36 @@ class WiFiManager_NINA_Lite
         }
       }
 
+#if USE_STICKY_DHCP
+      if ( wifi_connected && !updateDHCPLease(ipMode, index) )
+      {
+        // Same SSID again, now with DHCP, as the lease of this index is dropped
+        WiFi.end();
+        leaseApplied    = false;
+        wifi_connected  = false;
+
+        configIP(index);
+
+        while ( !wifi_connected && (0 < retries--) )
+        {
+          if (WiFi.begin(WIFININA_config.WiFi_Creds[index].wifi_ssid, WIFININA_config.WiFi_Creds[index].wifi_pw) == WL_CONNECTED)
+            wifi_connected = true;
+          else
+            delay(sleep_time);
+        }
+
+        if (wifi_connected)
+          updateDHCPLease(WM_IP_DHCP, index);
+      }
+#endif
+
       if (wifi_connected)
       {
         WN_LOGERROR(F("con2WF:OK"));
+
+        // New from v1.5.0
+        if (wifiPowerSave)
+          WiFi.lowPowerMode();
         
         WN_LOGERROR1(F("IP="), WiFi.localIP() );
         
@@ -1374,71 +2063,227 @@ class WiFiManager_NINA_Lite
     //////////////////////////////////////////////
 
     void createHTML(String& root_html_template)
-    {   
-      // -- HTML page fragments
-      root_html_template = "<!DOCTYPE html><html><head><title>AVR_WM_NINA_Lite</title><style>div,input{padding:5px;font-size:1em;}input{width:95%;}body{text-align: center;}button{background-color:#16A1E7;color:#fff;line-height:2.4rem;font-size:1.2rem;width:100%;}fieldset{border-radius:0.3rem;margin:0px;}</style></head><div style=\"text-align:left;display:inline-block;min-width:260px;\"><fieldset><div><label>*SSID</label><input value=\"[[id]]\"id=\"id\"><div></div></div><div><label>*PW (8+)</label><input value=\"[[pw]]\"id=\"pw\"><div></div></div><div><label>*SSID1</label><input value=\"[[id1]]\"id=\"id1\"><div></div></div><div><label>*PW1 (8+)</label><input value=\"[[pw1]]\"id=\"pw1\"><div></div></div></fieldset><fieldset><div><label>Board Name</label><input value=\"[[nm]]\"id=\"nm\"><div></div></div></fieldset>";
-
-      String WIFININA_FLDSET_START = "<fieldset>";
-      String WIFININA_FLDSET_END     = "</fieldset>";
-      String WIFININA_HTML_PARAM    = "<div><label>{b}</label><input value='[[{v}]]'id='{i}'><div></div></div>";
-      String WIFININA_HTML_BUTTON    = "<button onclick=\"sv()\">Save</button></div>";
-      String WIFININA_HTML_SCRIPT    = "<script id=\"jsbin-javascript\">function udVal(key,val){var request=new XMLHttpRequest();var url='/\
-?key='+key+'&value='+encodeURIComponent(val);request.open('GET',url,false);request.send(null);}\
-function sv(){udVal('id',document.getElementById('id').value);udVal('pw',document.getElementById('pw').value);\
-udVal('id1',document.getElementById('id1').value);udVal('pw1',document.getElementById('pw1').value);\
-udVal('nm',document.getElementById('nm').value);";
+    {
+      String pitem;
+      
+      root_html_template  = WIFININA_HTML_HEAD_START;
+      
+  #if USING_CUSTOMS_STYLE
+      // Using Customs style when not NULL
+      if (WIFININA_HTML_HEAD_CUSTOMS_STYLE)
+        root_html_template  += WIFININA_HTML_HEAD_CUSTOMS_STYLE;
+      else
+        root_html_template  += WIFININA_HTML_HEAD_STYLE;
+  #else     
+      root_html_template  += WIFININA_HTML_HEAD_STYLE;
+  #endif
+      
+  #if USING_CUSTOMS_HEAD_ELEMENT
+      if (_CustomsHeadElement)
+        root_html_template += _CustomsHeadElement;
+  #endif
 
-      String WIFININA_HTML_SCRIPT_ITEM   = "udVal('{d}',document.getElementById('{d}').value);";
+      pitem = String(WIFININA_HTML_HEAD_END);
+      pitem.replace("[[input_id]]",  WIFININA_HTML_INPUT_ID);
+      pitem.replace("[[input_id1]]", WIFININA_HTML_INPUT_ID1);
+      root_html_template += pitem + WIFININA_FLDSET_START;
 
-      String WIFININA_HTML_SCRIPT_END   = "alert('Updated');}</script>";
+#if USE_DYNAMIC_PARAMETERS      
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        pitem = String(WIFININA_HTML_PARAM);
 
-      String WIFININA_HTML_END   = "</html>";
-      ///
+        pitem.replace("{b}", myMenuItems[i].displayName);
+        pitem.replace("{v}", myMenuItems[i].id);
+        pitem.replace("{i}", myMenuItems[i].id);
+        
+        root_html_template += pitem;
+      }
+#endif
+      
+#if USE_STATIC_IP_CONFIG
+      root_html_template += String(WIFININA_FLDSET_END) + WIFININA_FLDSET_START + WIFININA_HTML_STATIC_IP;
+#endif
 
-      String pitem;
+      root_html_template += String(WIFININA_FLDSET_END) + WIFININA_HTML_BUTTON + WIFININA_HTML_SCRIPT + WIFININA_HTML_END;
       
-#if USE_DYNAMIC_PARAMETERS     
-      if (NUM_MENU_ITEMS > 0)
+      return;     
+    }
+
+#if USE_PAGE_STREAMING
+    // New from v1.5.0
+    // The page of createHTML(), with the values replaced by handleRequest(), written to page
+    void writePage(WiFiNINA_PageWriter& page)
+    {
+      auto value = [this](WiFiNINA_PageWriter& out, const char* token, size_t tokenLen)
       {
-        root_html_template += WIFI_GENERIC_FLDSET_START;
-           
-        for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+        return writePageValue(out, token, tokenLen);
+      };
+
+      if ( RFC952_hostname[0] != 0 )
+      {
+        page.setName("AVR_WM_NINA_Lite", RFC952_hostname);
+      }
+      else if ( WIFININA_config.board_name[0] != 0 )
+      {
+        page.setName("AVR_WM_NINA_Lite", WIFININA_config.board_name);
+      }
+
+      page.expand(WIFININA_HTML_HEAD_START, value);
+
+  #if USING_CUSTOMS_STYLE
+      // Using Customs style when not NULL
+      page.expand(WIFININA_HTML_HEAD_CUSTOMS_STYLE ? WIFININA_HTML_HEAD_CUSTOMS_STYLE : WIFININA_HTML_HEAD_STYLE, value);
+  #else
+      page.expand(WIFININA_HTML_HEAD_STYLE, value);
+  #endif
+
+  #if USING_CUSTOMS_HEAD_ELEMENT
+      if (_CustomsHeadElement)
+        page.expand(_CustomsHeadElement, value);
+  #endif
+
+      page.expand(WIFININA_HTML_HEAD_END, value);
+      page.expand(WIFININA_FLDSET_START, value);
+
+#if USE_DYNAMIC_PARAMETERS
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        page.expand(WIFININA_HTML_PARAM, [this, i](WiFiNINA_PageWriter& out, const char* token, size_t tokenLen)
         {
-          pitem = String(WIFI_GENERIC_HTML_PARAM);
+          if (token[0] == '{')
+          {
+            // {b} is the label, {v} and {i} the id
+            if ( (token[1] != 'b') && (token[1] != 'v') && (token[1] != 'i') )
+              return false;
 
-          pitem.replace("{b}", myMenuItems[i].displayName);
-          pitem.replace("{v}", myMenuItems[i].id);
-          pitem.replace("{i}", myMenuItems[i].id);
-          
-          root_html_template += pitem;      
+            out.print( (token[1] == 'b') ? myMenuItems[i].displayName : myMenuItems[i].id );
+
+            return true;
+          }
+
+          if (!WiFiNINA_isPageKey(token, tokenLen, "{v}"))
+            return writePageValue(out, token, tokenLen);
+
+          // [[{v}]] is [[id]], then its value
+          char key[MAX_ID_LEN + 5];
+
+          snprintf(key, sizeof(key), "[[%s]]", myMenuItems[i].id);
+
+          if (!writePageValue(out, key, strlen(key)))
+            out.print(key);
+
+          return true;
+        });
+      }
+#endif
+
+#if USE_STATIC_IP_CONFIG
+      page.expand(WIFININA_FLDSET_END, value);
+      page.expand(WIFININA_FLDSET_START, value);
+      page.expand(WIFININA_HTML_STATIC_IP, value);
+#endif
+
+      page.expand(WIFININA_FLDSET_END, value);
+      page.expand(WIFININA_HTML_BUTTON, value);
+      page.expand(WIFININA_HTML_SCRIPT, value);
+      page.expand(WIFININA_HTML_END, value);
+    }
+
+    //////////////////////////////////////////////
+
+    // Write the value of token, [[key]] of the page. Return false if unknown
+    bool writePageValue(WiFiNINA_PageWriter& page, const char* token, size_t tokenLen)
+    {
+      if ( WiFiNINA_isPageKey(token, tokenLen, "input_id") || WiFiNINA_isPageKey(token, tokenLen, "input_id1") )
+      {
+        page.expand( (tokenLen == 12) ? WIFININA_HTML_INPUT_ID : WIFININA_HTML_INPUT_ID1,
+                     [this](WiFiNINA_PageWriter& out, const char* key, size_t keyLen) { return writePageValue(out, key, keyLen); } );
+
+        return true;
+      }
+
+      static const char* const credKeys[] = { "id", "pw", "id1", "pw1" };
+
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        if (WiFiNINA_isPageKey(token, tokenLen, credKeys[i]))
+        {
+          if (hadConfigData)
+            page.print( (i % 2) ? WIFININA_config.WiFi_Creds[i / 2].wifi_pw : WIFININA_config.WiFi_Creds[i / 2].wifi_ssid );
+
+          return true;
+        }
+      }
+
+      if (WiFiNINA_isPageKey(token, tokenLen, "nm"))
+      {
+        if (hadConfigData)
+          page.print(WIFININA_config.board_name);
+
+        return true;
+      }
+
+#if USE_STATIC_IP_CONFIG
+      static const char* const ipKeys[] = { "ip", "gw", "sn", "dns" };
+
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        if (WiFiNINA_isPageKey(token, tokenLen, ipKeys[i]))
+        {
+          if (hadConfigData)
+            page.print(WiFiNINA_staticIPFieldToString(WiFiNINA_staticIPField(WIFININA_config.staticIP, WM_KEY_IP + i)));
+
+          return true;
         }
-            
-        root_html_template += WIFI_GENERIC_FLDSET_END;
       }
 #endif
-         
-      root_html_template += WIFININA_HTML_BUTTON;
-      root_html_template += WIFININA_HTML_SCRIPT;
-      
-#if USE_DYNAMIC_PARAMETERS           
-      if (NUM_MENU_ITEMS > 0)
-      {        
-        for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+
+#if USE_DYNAMIC_PARAMETERS
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        if (WiFiNINA_isPageKey(token, tokenLen, myMenuItems[i].id))
         {
-          pitem = String(WIFI_GENERIC_HTML_SCRIPT_ITEM);
-          
-          pitem.replace("{d}", myMenuItems[i].id);
-          
-          root_html_template += pitem;        
+          page.print(WiFiNINA_menuItemToString(myMenuItems[i]));
+
+          return true;
         }
       }
 #endif
-      
-      root_html_template += WIFININA_HTML_SCRIPT_END;
-      root_html_template += WIFININA_HTML_END;
-           
-      return;     
+
+      return false;
+    }
+
+    //////////////////////////////////////////////
+
+    // Send the page with its Content-Length, then the page itself, without holding it in a String
+    void sendPage()
+    {
+      size_t length;
+
+      {
+        WiFiNINA_PageWriter counter;
+
+        writePage(counter);
+        length = counter.length();
+      }
+
+      WN_LOGDEBUG1(F("h:HTML page size:"), length);
+
+      server->setContentLength(length);
+      server->send(200, "text/html", "");
+
+      WiFiClient          client = server->client();
+      WiFiNINA_PageWriter page(&client);
+
+      writePage(page);
+
+      if (!page.flush())
+      {
+        WN_LOGDEBUG(F("h:PageNotSent"));
+      }
     }
+#endif    // USE_PAGE_STREAMING
     
     //////////////////////////////////////////////
 
@@ -1462,6 +2307,115 @@ udVal('nm',document.getElementById('nm').value);";
     
     //////////////////////////////////////////////
 
+    // New from v1.5.0
+    // The next Config Data from Config Portal starts again with no item
+    void clearItemsUpdated()
+    {
+      number_items_Updated  = 0;
+      id_Updated            = false;
+      pw_Updated            = false;
+      id1_Updated           = false;
+      pw1_Updated           = false;
+      nm_Updated            = false;
+
+#if USE_STATIC_IP_CONFIG
+      ip_Updated            = 0;
+#endif
+
+#if USE_DYNAMIC_PARAMETERS
+      if (menuItemUpdated)
+      {
+        for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+        {
+          menuItemUpdated[i] = false;
+        }
+      }
+#endif
+    }
+
+    //////////////////////////////////////////////
+
+    // Config Data is saved, from Config Portal
+    void configSaved()
+    {
+      clearItemsUpdated();
+
+#if USE_LIVE_RECONFIG
+      // New from v1.5.0. Applied by run(), without blocking here
+      reconfigureTime     = millis();
+      reconfigurePending  = true;
+#else
+      WN_LOGDEBUG(F("h:Rst"));
+
+      // Delay then reset the board after save data
+      delay(1000);
+      resetFunc();  //call reset
+#endif
+    }
+
+#if USE_RUN_SERVICES
+    // New from v1.5.0
+    void runServices()
+    {
+      for (uint8_t i = 0; i < numServices; i++)
+      {
+        services[i]->runService(wifi_connected, WM_SERVICE_TIME_SLICE);
+      }
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_LIVE_RECONFIG
+    // New from v1.5.0
+    // Stop Config Portal, then connect with the saved Config Data, as begin() does after reset. Reset if no WiFi
+    void reconfigure()
+    {
+      reconfigurePending = false;
+
+#if USE_CAPTIVE_PORTAL_DNS
+      if (dnsServer)
+      {
+        dnsServer->stop();
+        delete dnsServer;
+        dnsServer = NULL;
+      }
+#endif
+
+      // Stops the AP, and drops its IP config and sockets
+      WiFi.end();
+
+      // Its handlers are added again by the next startConfigurationMode()
+      if (server)
+      {
+        delete server;
+        server = NULL;
+      }
+
+#if USE_STICKY_DHCP
+      leaseApplied    = false;
+#endif
+
+      wifi_connected  = false;
+
+      if (connectMultiWiFi(RETRY_TIMES_CONNECT_WIFI))
+      {
+        WN_LOGERROR(F("r:ReconfWOK"));
+
+        hadConfigData       = true;
+        configuration_mode  = false;
+      }
+      else
+      {
+        WN_LOGERROR(F("r:ReconfNoW.Rst"));
+
+        resetFunc();  //call reset
+      }
+    }
+#endif
+
+    //////////////////////////////////////////////
+
     void handleRequest()
     {
       if (server)
@@ -1469,14 +2423,20 @@ udVal('nm',document.getElementById('nm').value);";
         String key    = server->arg("key");
         String value  = server->arg("value");
 
-        static int number_items_Updated = 0;
-
         if (key == "" && value == "")
         {
           // New from v1.1.0         
           serverSendHeaders();        
           //////
           
+#if USE_PAGE_STREAMING
+          // Reset configTimeout to stay here until finished.
+          configTimeout = 0;
+
+          sendPage();
+
+          return;
+#else
           String result;
           createHTML(result);
 
@@ -1510,12 +2470,16 @@ udVal('nm',document.getElementById('nm').value);";
             result.replace("[[pw1]]", "");
             result.replace("[[nm]]",  "");
           }
+
+#if USE_STATIC_IP_CONFIG
+          WiFiNINA_replaceStaticIP(result, hadConfigData ? &WIFININA_config.staticIP : NULL);
+#endif
           
 #if USE_DYNAMIC_PARAMETERS          
           for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
           {
             String toChange = String("[[") + myMenuItems[i].id + "]]";
-            result.replace(toChange, myMenuItems[i].pdata);
+            result.replace(toChange, WiFiNINA_menuItemToString(myMenuItems[i]));
           }
 #endif
 
@@ -1526,8 +2490,19 @@ udVal('nm',document.getElementById('nm').value);";
           server->send(200, "text/html", result);
 
           return;
+#endif
         }
 
+#if USE_LIVE_RECONFIG
+        // Saved, and not yet applied by reconfigure()
+        if (reconfigurePending)
+        {
+          server->send(200, "text/html", "OK");
+
+          return;
+        }
+#endif
+
         if (number_items_Updated == 0)
         {
           memset(&WIFININA_config, 0, sizeof(WIFININA_config));
@@ -1555,15 +2530,26 @@ udVal('nm',document.getElementById('nm').value);";
             WN_LOGERROR(F("h: Error can't alloc memory for menuItemUpdated" ));
           }
         }  
+
+        if (!menuItemIndex)
+        {
+          // Don't need to free
+          menuItemIndex = new uint16_t[NUM_MENU_ITEMS];
+
+          if (menuItemIndex)
+          {
+            WiFiNINA_buildMenuItemIndex(myMenuItems, menuItemIndex, NUM_MENU_ITEMS);
+          }
+          else
+          {
+            WN_LOGERROR(F("h: Error can't alloc memory for menuItemIndex" ));
+          }
+        }
 #endif
 
-        static bool id_Updated  = false;
-        static bool pw_Updated  = false;
-        static bool id1_Updated = false;
-        static bool pw1_Updated = false;
-        static bool nm_Updated  = false;
+        uint8_t builtinKey = WiFiNINA_builtinKey(key.c_str());
           
-        if (!id_Updated && (key == String("id")))
+        if (!id_Updated && (builtinKey == WM_KEY_ID))
         {   
           WN_LOGDEBUG(F("h:repl id"));
           id_Updated = true;
@@ -1574,7 +2560,7 @@ udVal('nm',document.getElementById('nm').value);";
           else
             strncpy(WIFININA_config.WiFi_Creds[0].wifi_ssid, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[0].wifi_ssid) - 1);
         }
-        else if (!pw_Updated && (key == String("pw")))
+        else if (!pw_Updated && (builtinKey == WM_KEY_PW))
         {    
           WN_LOGDEBUG(F("h:repl pw"));
           pw_Updated = true;
@@ -1585,7 +2571,7 @@ udVal('nm',document.getElementById('nm').value);";
           else
             strncpy(WIFININA_config.WiFi_Creds[0].wifi_pw, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[0].wifi_pw) - 1);
         }
-        else if (!id1_Updated && (key == String("id1")))
+        else if (!id1_Updated && (builtinKey == WM_KEY_ID1))
         {   
           WN_LOGDEBUG(F("h:repl id1"));
           id1_Updated = true;
@@ -1596,7 +2582,7 @@ udVal('nm',document.getElementById('nm').value);";
           else
             strncpy(WIFININA_config.WiFi_Creds[1].wifi_ssid, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[1].wifi_ssid) - 1);
         }
-        else if (!pw1_Updated && (key == String("pw1")))
+        else if (!pw1_Updated && (builtinKey == WM_KEY_PW1))
         {    
           WN_LOGDEBUG(F("h:repl pw1"));
           pw1_Updated = true;
@@ -1607,7 +2593,7 @@ udVal('nm',document.getElementById('nm').value);";
           else
             strncpy(WIFININA_config.WiFi_Creds[1].wifi_pw, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[1].wifi_pw) - 1);
         }
-        else if (!nm_Updated && (key == String("nm")))
+        else if (!nm_Updated && (builtinKey == WM_KEY_NM))
         {
           WN_LOGDEBUG(F("h:repl nm"));
           nm_Updated = true;
@@ -1618,30 +2604,41 @@ udVal('nm',document.getElementById('nm').value);";
           else
             strncpy(WIFININA_config.board_name, value.c_str(), sizeof(WIFININA_config.board_name) - 1);
         }
+#if USE_STATIC_IP_CONFIG
+        else if ( WiFiNINA_staticIPField(WIFININA_config.staticIP, builtinKey)
+                  && !(ip_Updated & (1 << (builtinKey - WM_KEY_IP))) )
+        {
+          WN_LOGDEBUG1(F("h:repl "), key);
+          ip_Updated |= (1 << (builtinKey - WM_KEY_IP));
+
+          number_items_Updated++;
+
+          // An invalid address keeps the current one
+          if (!WiFiNINA_setStaticIPField(WiFiNINA_staticIPField(WIFININA_config.staticIP, builtinKey), value.c_str()))
+          {
+            WN_LOGERROR3(F("h:Invalid "), key, F("="), value);
+          }
+        }
+#endif
 
         
 #if USE_DYNAMIC_PARAMETERS
         else
         {
-          for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
-          {           
-            if ( !menuItemUpdated[i] && (key == myMenuItems[i].id) )
-            {
-              WN_LOGDEBUG3(F("h:"), myMenuItems[i].id, F("="), value.c_str() );
+          int i = menuItemIndex ? WiFiNINA_findMenuItem(myMenuItems, menuItemIndex, NUM_MENU_ITEMS, key.c_str()) : -1;
+
+          if ( (i >= 0) && menuItemUpdated && !menuItemUpdated[i] )
+          {
+            WN_LOGDEBUG3(F("h:"), myMenuItems[i].id, F("="), value.c_str() );
               
-              menuItemUpdated[i] = true;
+            menuItemUpdated[i] = true;
               
-              number_items_Updated++;
-
-              // Actual size of pdata is [maxlen + 1]
-              memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+            number_items_Updated++;
 
-              if ((int) strlen(value.c_str()) < myMenuItems[i].maxlen)
-                strcpy(myMenuItems[i].pdata, value.c_str());
-              else
-                strncpy(myMenuItems[i].pdata, value.c_str(), myMenuItems[i].maxlen);
-                
-              break;  
+            // Typed items are validated here. An invalid value keeps the current one
+            if (!WiFiNINA_setMenuItem(myMenuItems[i], value.c_str()))
+            {
+              WN_LOGERROR3(F("h:Invalid "), myMenuItems[i].id, F("="), value);
             }
           }
         }  
@@ -1662,15 +2659,138 @@ udVal('nm',document.getElementById('nm').value);";
 
           saveConfigData();
 
-          WN_LOGDEBUG(F("h:Rst"));
-
-          // TO DO : what command to reset
-          // Delay then reset the board after save data
-          delay(1000);
-          resetFunc();  //call reset
+          configSaved();
         }
       }   // if (server)
     }
+
+    //////////////////////////////////////////////
+
+    // New from v1.5.0
+    // Gzipped style and script of Config Portal page. Their URLs change with their content, so they can be cached for good
+    void handleAsset(const char* contentType, const uint8_t* data, uint16_t length)
+    {
+      if (server)
+      {
+        server->sendHeader("Content-Encoding", "gzip");
+        server->sendHeader("Cache-Control", "max-age=31536000");
+        server->send_P(200, contentType, (PGM_P) data, length);
+      }
+    }
+
+    //////////////////////////////////////////////
+
+#if USE_JSON_CONFIG_API
+    // New from v1.5.0
+    // GET /config.json exports, POST /config.json imports and saves Config Data and Dynamic Parameters in one request
+    void handleConfigJson()
+    {
+      if (server)
+      {
+        // Reset configTimeout to stay here until finished.
+        configTimeout = 0;
+
+        serverSendHeaders();
+
+        if (server->method() != HTTP_POST)
+        {
+          server->send(200, "application/json", WiFiNINA_configToJson(WIFININA_config));
+
+          return;
+        }
+
+#if USE_LIVE_RECONFIG
+        // Saved, and not yet applied by reconfigure(). Not changed meanwhile
+        if (reconfigurePending)
+        {
+          server->send(409, "application/json", "{\"error\":\"pending\",\"key\":\"\"}");
+
+          return;
+        }
+#endif
+
+        String json = server->arg("plain");
+        char   errorKey[MAX_ID_LEN + 2];
+
+        // Validate all, before changing anything
+        if (!WiFiNINA_parseConfigJson(json.c_str(), json.length(), WIFININA_config, false, errorKey))
+        {
+          WN_LOGERROR1(F("h:Invalid JSON, key="), errorKey);
+
+          server->send(400, "application/json", WiFiNINA_jsonError(errorKey));
+
+          return;
+        }
+
+        if (!hadConfigData)
+        {
+          // Don't keep invalid data for the keys not in the request
+          memset(&WIFININA_config, 0, sizeof(WIFININA_config));
+        }
+
+        WiFiNINA_parseConfigJson(json.c_str(), json.length(), WIFININA_config, true, errorKey);
+        strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
+
+        WN_LOGDEBUG(F("h:UpdJSON"));
+
+        saveConfigData();
+
+        server->send(200, "application/json", "{\"saved\":true}");
+
+        configSaved();
+      }
+    }
+#endif
+    
+    //////////////////////////////////////////////
+
+#if USE_SERIAL_CONFIG
+    // New from v1.5.0
+    // READ returns, WRITE saves the whole Config image : Config Data, Dynamic Parameters and forced CP flag.
+    // RESET makes the written data effective
+    void handleSerialConfig()
+    {
+      uint8_t request = serialConfig.poll();
+
+      if (request == WM_SC_READ)
+      {
+        uint8_t forcedCP = isForcedConfigPortal ? ( persForcedConfigPortal ? WM_SC_CP_PERSISTENT : WM_SC_CP_ONCE ) : WM_SC_CP_NONE;
+
+        serialConfig.sendImage(WIFININA_config, forcedCP);
+      }
+      else if (request == WM_SC_WRITE)
+      {
+        uint8_t forcedCP;
+        uint8_t status = serialConfig.getImage(WIFININA_config, forcedCP);
+
+        if (status == WM_SC_OK)
+        {
+          NULLTerminateConfig();
+          strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
+
+          WN_LOGDEBUG(F("SC:Upd"));
+
+          saveConfigData();
+
+          if (forcedCP == WM_SC_CP_NONE)
+            clearForcedCP();
+          else
+            setForcedCP(forcedCP == WM_SC_CP_PERSISTENT);
+        }
+
+        serialConfig.sendStatus(status);
+      }
+      else if (request == WM_SC_RESET)
+      {
+        serialConfig.sendStatus(WM_SC_OK);
+
+        WN_LOGDEBUG(F("SC:Rst"));
+
+        delay(100);
+        resetFunc();  //call reset
+      }
+    }
+#endif
     
     //////////////////////////////////////////////
 
@@ -1716,7 +2836,7 @@ udVal('nm',document.getElementById('nm').value);";
 
       if (!server)
       {
-        server = new WiFiWebServer;
+        server = new WiFiNINA_WebServer;
       }
 
       //See https://stackoverflow.com/questions/39803135/c-unresolved-overloaded-function-type?rq=1
@@ -1724,9 +2844,36 @@ udVal('nm',document.getElementById('nm').value);";
       if (server)
       {
         server->on("/", [this](){ handleRequest(); });
+
+        // New from v1.5.0
+        server->on(WIFININA_CSS_PATH, [this](){ handleAsset(WIFININA_CSS_TYPE, WIFININA_CSS_GZ, sizeof(WIFININA_CSS_GZ)); });
+        server->on(WIFININA_JS_PATH,  [this](){ handleAsset(WIFININA_JS_TYPE,  WIFININA_JS_GZ,  sizeof(WIFININA_JS_GZ)); });
+
+#if USE_JSON_CONFIG_API
+        server->on("/config.json", [this](){ handleConfigJson(); });
+#endif
+
+#if USE_CAPTIVE_PORTAL_DNS
+        // New from v1.5.0. OS connectivity checks and any other page are redirected to Config Portal
+        server->onNotFound([this](){ WiFiNINA_redirectToPortal(server, portal_apIP); });
+#endif
+
         server->begin();
       }
 
+#if USE_CAPTIVE_PORTAL_DNS
+      if (!dnsServer)
+      {
+        // Every name resolves to portal_apIP while in Config Portal
+        dnsServer = new WiFiNINA_DNSServer;
+
+        if (dnsServer)
+        {
+          dnsServer->start(portal_apIP);
+        }
+      }
+#endif
+
       // If there is no saved config Data, stay in config mode forever until having config Data.
       // or SSID, PW, Server,Token ="nothing"
       if (hadConfigData)
@@ -0,0 +1,132 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Backoff.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Reconnect scheduler with exponential backoff and decorrelated jitter.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Backoff_h
+#define WiFiManager_NINA_Lite_Backoff_h
+
+// New from v1.5.0
+// After WiFi is lost, run() tries to reconnect only at scheduled times, instead of in every call. Each failed try makes
+// the next wait random in [base, 3 x previous wait], capped at WM_RECONNECT_MAX_DELAY. Waits grow about exponentially,
+// and the devices losing the same AP at the same time spread their tries out, instead of all trying together.
+#ifndef USE_RECONNECT_BACKOFF
+  #define USE_RECONNECT_BACKOFF             false
+#endif
+
+#ifndef WM_RECONNECT_BASE_DELAY
+  // ms. Min wait, and the wait after the first failed try is up to 3 times this
+  #define WM_RECONNECT_BASE_DELAY           5000L
+#endif
+
+#ifndef WM_RECONNECT_MAX_DELAY
+  // ms. Max wait
+  #define WM_RECONNECT_MAX_DELAY            60000L
+#endif
+
+// Also used by WiFiNINA_MQTT_Service, for broker reconnects
+class WiFiNINA_Backoff
+{
+  public:
+
+    WiFiNINA_Backoff()
+    {
+      setDelays(WM_RECONNECT_BASE_DELAY, WM_RECONNECT_MAX_DELAY);
+    }
+
+    void setDelays(unsigned long baseDelay, unsigned long maxDelay)
+    {
+      base  = (baseDelay > 0) ? baseDelay : 1;
+      cap   = (maxDelay > base) ? maxDelay : base;
+
+      succeeded();
+    }
+
+    // Use something unique to the device, such as its MAC, so that devices don't draw the same waits
+    void seed(const uint8_t* data, uint8_t length)
+    {
+      randomState ^= micros();
+
+      for (uint8_t i = 0; i < length; i++)
+      {
+        randomState = (randomState ^ data[i]) * 16777619UL;
+      }
+
+      if (randomState == 0)
+        randomState = 1;
+    }
+
+    // True if a try can be made now
+    bool due(unsigned long now) const
+    {
+      return ( (attempts == 0) || ((long) (now - nextAttempt) >= 0) );
+    }
+
+    void failed(unsigned long now)
+    {
+      // Decorrelated jitter : wait = min(cap, random(base, 3 x wait))
+      unsigned long upper = (wait > cap / 3) ? cap : 3 * wait;
+
+      wait = base + nextRandom() % (upper - base + 1);
+
+      nextAttempt = now + wait;
+
+      if (attempts < 0xFFFF)
+        attempts++;
+    }
+
+    void succeeded()
+    {
+      wait      = base;
+      attempts  = 0;
+    }
+
+    // Failed tries since WiFi was lost, 0 when connected
+    uint16_t getAttempts() const
+    {
+      return attempts;
+    }
+
+    // Current wait, in ms
+    unsigned long getDelay() const
+    {
+      return (attempts == 0) ? 0 : wait;
+    }
+
+    // Time to the next try, in ms
+    unsigned long getTimeToNextAttempt(unsigned long now) const
+    {
+      return due(now) ? 0 : (nextAttempt - now);
+    }
+
+  private:
+
+    unsigned long base;
+    unsigned long cap;
+    unsigned long wait;
+    unsigned long nextAttempt = 0;
+    uint16_t      attempts    = 0;
+    uint32_t      randomState = 2166136261UL;
+
+    // xorshift32. Own state, not disturbed by the sketch using random() / randomSeed()
+    uint32_t nextRandom()
+    {
+      randomState ^= randomState << 13;
+      randomState ^= randomState >> 17;
+      randomState ^= randomState << 5;
+
+      return randomState;
+    }
+};
+
+#endif    // WiFiManager_NINA_Lite_Backoff_h
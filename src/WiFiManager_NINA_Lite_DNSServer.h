@@ -0,0 +1,188 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_DNSServer.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Captive Portal DNS responder. Answers every A query with the Config Portal AP IP.
+  Must be included after WiFiManager_NINA_Lite_PortalServer.h
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_DNSServer_h
+#define WiFiManager_NINA_Lite_DNSServer_h
+
+// New from v1.5.0
+// With every name resolving to the AP IP, the connectivity checks of phones and PCs (/generate_204,
+// /hotspot-detect.html, /connecttest.txt, etc.) reach Config Portal and are redirected to it, so that the
+// Config Portal page pops up by itself once connected to the AP.
+#ifndef USE_CAPTIVE_PORTAL_DNS
+  #define USE_CAPTIVE_PORTAL_DNS            false
+#endif
+
+#if USE_CAPTIVE_PORTAL_DNS
+
+#ifndef WM_DNS_PORT
+  #define WM_DNS_PORT                       53
+#endif
+
+#ifndef WM_DNS_TTL
+  #define WM_DNS_TTL                        60
+#endif
+
+#ifndef WM_DNS_MAX_PACKETS_PER_CALL
+  // Budget for each processRequests() call
+  #define WM_DNS_MAX_PACKETS_PER_CALL       4
+#endif
+
+#ifndef WM_DNS_BUFFER_SIZE
+  // Longer queries are dropped. Common queries with a single question are well below this
+  #define WM_DNS_BUFFER_SIZE                128
+#endif
+
+#define WM_DNS_HEADER_SIZE                  12
+#define WM_DNS_ANSWER_SIZE                  16
+#define WM_DNS_TYPE_A                       1
+#define WM_DNS_TYPE_ANY                     255
+#define WM_DNS_CLASS_IN                     1
+
+class WiFiNINA_DNSServer
+{
+  public:
+
+    void start(const IPAddress& ip)
+    {
+      for (uint8_t i = 0; i < 4; i++)
+        resolvedIP[i] = ip[i];
+
+      udp.begin(WM_DNS_PORT);
+    }
+
+    void stop()
+    {
+      udp.stop();
+    }
+
+    // Answer up to WM_DNS_MAX_PACKETS_PER_CALL pending queries, without blocking
+    void processRequests()
+    {
+      for (uint8_t i = 0; i < WM_DNS_MAX_PACKETS_PER_CALL; i++)
+      {
+        int packetSize = udp.parsePacket();
+
+        if (packetSize <= 0)
+          return;
+
+        // Unread data is discarded by the next parsePacket()
+        if (packetSize > WM_DNS_BUFFER_SIZE - WM_DNS_ANSWER_SIZE)
+          continue;
+
+        int length = udp.read(buffer, packetSize);
+
+        if (length == packetSize)
+        {
+          length = buildResponse(length);
+
+          if (length > 0)
+          {
+            udp.beginPacket(udp.remoteIP(), udp.remotePort());
+            udp.write(buffer, length);
+            udp.endPacket();
+          }
+        }
+      }
+    }
+
+  private:
+
+    WiFiUDP   udp;
+    uint8_t   resolvedIP[4];
+    uint8_t   buffer[WM_DNS_BUFFER_SIZE];
+
+    // Turn the query in buffer into its response, in place. Return the response length, or 0 to drop the query
+    int buildResponse(int length)
+    {
+      // Header : ID(2) FLAGS(2) QDCOUNT(2) ANCOUNT(2) NSCOUNT(2) ARCOUNT(2)
+      if ( (length < WM_DNS_HEADER_SIZE) || (buffer[2] & 0x80) || (buffer[2] & 0x78) )
+      {
+        // Too short, a response, or not a standard query
+        return 0;
+      }
+
+      if ( (buffer[4] != 0) || (buffer[5] == 0) )
+        return 0;
+
+      // Walk the name of the first question
+      int position = WM_DNS_HEADER_SIZE;
+
+      while ( (position < length) && (buffer[position] != 0) )
+      {
+        // No compression pointer in a question, label max 63 chars
+        if (buffer[position] > 63)
+          return 0;
+
+        position += buffer[position] + 1;
+      }
+
+      // Root label + QTYPE(2) + QCLASS(2)
+      if (position + 5 > length)
+        return 0;
+
+      uint16_t type  = (buffer[position + 1] << 8) | buffer[position + 2];
+      uint16_t klass = (buffer[position + 3] << 8) | buffer[position + 4];
+
+      // Keep only the first question
+      length = position + 5;
+
+      bool answer = ( (klass == WM_DNS_CLASS_IN) && ( (type == WM_DNS_TYPE_A) || (type == WM_DNS_TYPE_ANY) ) );
+
+      buffer[2]  = 0x84 | (buffer[2] & 0x01);   // QR, AA, keep RD
+      buffer[3]  = 0x00;                        // RA = 0, RCODE = NOERROR
+      buffer[5]  = 1;                           // QDCOUNT
+      buffer[6]  = 0;
+      buffer[7]  = answer ? 1 : 0;              // ANCOUNT. Other types get an empty answer, no AAAA to wait for
+      memset(&buffer[8], 0, 4);                 // NSCOUNT, ARCOUNT
+
+      if (!answer)
+        return length;
+
+      uint8_t* record = &buffer[length];
+
+      record[0]  = 0xC0;                        // Name : pointer to the question name
+      record[1]  = WM_DNS_HEADER_SIZE;
+      record[2]  = 0;
+      record[3]  = WM_DNS_TYPE_A;
+      record[4]  = 0;
+      record[5]  = WM_DNS_CLASS_IN;
+      record[6]  = (uint8_t) ((uint32_t) WM_DNS_TTL >> 24);
+      record[7]  = (uint8_t) ((uint32_t) WM_DNS_TTL >> 16);
+      record[8]  = (uint8_t) ((uint32_t) WM_DNS_TTL >> 8);
+      record[9]  = (uint8_t) WM_DNS_TTL;
+      record[10] = 0;
+      record[11] = 4;
+      memcpy(&record[12], resolvedIP, 4);
+
+      return length + WM_DNS_ANSWER_SIZE;
+    }
+};
+
+//////////////////////////////////////////////
+
+// Redirect a request for an unknown page, such as an OS connectivity check, to Config Portal
+inline void WiFiNINA_redirectToPortal(WiFiNINA_WebServer* server, const IPAddress& ip)
+{
+  String location = String("http://") + ip[0] + "." + ip[1] + "." + ip[2] + "." + ip[3] + "/";
+
+  server->sendHeader("Location", location, true);
+  server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
+  server->send(302, "text/plain", "");
+}
+
+#endif    // USE_CAPTIVE_PORTAL_DNS
+
+#endif    // WiFiManager_NINA_Lite_DNSServer_h
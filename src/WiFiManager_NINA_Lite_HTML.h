@@ -0,0 +1,93 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_HTML.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Config Portal page fragments, style and script, shared by all boards.
+  GENERATED by utils/wm_html_build.py from utils/html. Edit the sources there, then run the script again.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_HTML_h
+#define WiFiManager_NINA_Lite_HTML_h
+
+// Style and script, linked by URL. Served by the board with the gzip bytes below
+const char WIFININA_HTML_HEAD_STYLE[] /*PROGMEM*/ = "<link rel='stylesheet' href='/wm.css?v=dccc0fdd'>";
+const char WIFININA_HTML_SCRIPT[]     /*PROGMEM*/ = "<script src='/wm.js?v=2eeb515a'></script>";
+
+const char WIFININA_HTML_HEAD_END[]     /*PROGMEM*/ = "</head><div style='text-align:left;display:inline-block;min-width:260px;'><fieldset><div><label>*WiFi SSID</label><div>[[input_id]]</div></div><div><label>*PWD (8+ chars)</label><input value='[[pw]]' id='pw'><div></div></div><div><label>*WiFi SSID1</label><div>[[input_id1]]</div></div><div><label>*PWD1 (8+ chars)</label><input value='[[pw1]]' id='pw1'><div></div></div></fieldset><fieldset><div><label>Board Name</label><input value='[[nm]]' id='nm'><div></div></div></fieldset>";
+const char WIFININA_HTML_INPUT_ID[]     /*PROGMEM*/ = "<input value='[[id]]' id='id'>";
+const char WIFININA_HTML_INPUT_ID1[]    /*PROGMEM*/ = "<input value='[[id1]]' id='id1'>";
+const char WIFININA_FLDSET_START[]      /*PROGMEM*/ = "<fieldset>";
+const char WIFININA_FLDSET_END[]        /*PROGMEM*/ = "</fieldset>";
+const char WIFININA_HTML_PARAM[]        /*PROGMEM*/ = "<div><label>{b}</label><input value='[[{v}]]' id='{i}'><div></div></div>";
+const char WIFININA_HTML_BUTTON[]       /*PROGMEM*/ = "<button onclick='sv()'>Save</button></div>";
+const char WIFININA_HTML_END[]          /*PROGMEM*/ = "</html>";
+const char WIFININA_SELECT_START[]      /*PROGMEM*/ = "<select id=";
+const char WIFININA_SELECT_END[]        /*PROGMEM*/ = "</select>";
+const char WIFININA_DATALIST_START[]    /*PROGMEM*/ = "<datalist id=";
+const char WIFININA_DATALIST_END[]      /*PROGMEM*/ = "</datalist>";
+const char WIFININA_NO_NETWORKS_FOUND[] /*PROGMEM*/ = "No suitable WiFi networks available!";
+
+#define WIFININA_CSS_PATH                  "/wm.css"
+#define WIFININA_CSS_TYPE                  "text/css"
+
+const uint8_t WIFININA_CSS_GZ[] PROGMEM =
+{
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x55, 0x8D, 0xCB, 0x0E, 0x82, 0x30,
+  0x10, 0x00, 0x3F, 0xC6, 0x70, 0xA3, 0x04, 0xF0, 0x15, 0xCB, 0xC9, 0x83, 0x1F, 0x52, 0xD8, 0x6D,
+  0xD9, 0x58, 0xB6, 0xA4, 0x2C, 0x8A, 0x92, 0xFE, 0xBB, 0x31, 0x7A, 0xD0, 0xE3, 0x4C, 0x26, 0x19,
+  0xA0, 0x5B, 0x4E, 0x3C, 0xCE, 0x92, 0x4F, 0xE8, 0xB1, 0x93, 0x75, 0x34, 0x00, 0xC4, 0x4E, 0xEF,
+  0xC7, 0xA5, 0xB1, 0x81, 0x45, 0x4D, 0xF4, 0x44, 0x5D, 0xE1, 0x90, 0xFE, 0xB2, 0x3B, 0x81, 0xF4,
+  0xFA, 0xB4, 0xCF, 0x52, 0x1B, 0xE0, 0xB1, 0x0A, 0x2E, 0xA2, 0x8C, 0x27, 0xC7, 0xBA, 0x43, 0x16,
+  0x8C, 0xA9, 0x9D, 0x45, 0x02, 0xAF, 0xAD, 0xE9, 0xAE, 0x2E, 0x86, 0x99, 0x41, 0x75, 0xC1, 0x87,
+  0xA8, 0x37, 0xD5, 0xE1, 0x5C, 0x5D, 0x8E, 0xCD, 0x97, 0xAC, 0xB5, 0x8D, 0x27, 0x46, 0xD5, 0x23,
+  0xB9, 0x5E, 0x74, 0x5D, 0xEC, 0x22, 0x0E, 0xBF, 0xE7, 0xA2, 0x7E, 0x8B, 0xCF, 0xAF, 0x2A, 0xCB,
+  0x2C, 0x59, 0x42, 0x0F, 0x13, 0xCA, 0xDA, 0x86, 0x08, 0x18, 0x55, 0x34, 0x40, 0xF3, 0xA4, 0xCB,
+  0x62, 0xFB, 0x0E, 0x07, 0x13, 0x1D, 0xB1, 0x2E, 0xC7, 0x25, 0xBD, 0x00, 0xDD, 0x0F, 0xCC, 0xDC,
+  0xDC, 0x00, 0x00, 0x00
+};
+
+#define WIFININA_JS_PATH                   "/wm.js"
+#define WIFININA_JS_TYPE                   "application/javascript"
+
+const uint8_t WIFININA_JS_GZ[] PROGMEM =
+{
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x52, 0x5D, 0x6F, 0x13, 0x31,
+  0x10, 0xFC, 0x2B, 0xE1, 0x25, 0xF6, 0x29, 0xA7, 0x6B, 0x79, 0x36, 0x16, 0x82, 0x12, 0x41, 0x24,
+  0xA8, 0x50, 0x93, 0x20, 0xA4, 0x34, 0x0F, 0xD6, 0x79, 0x2F, 0xB1, 0x70, 0x6C, 0xE3, 0x8F, 0x40,
+  0x14, 0xDD, 0x7F, 0x67, 0x7D, 0x4E, 0x7A, 0x88, 0x56, 0xE2, 0x65, 0xB5, 0xF6, 0xEE, 0x8C, 0x67,
+  0x67, 0xDD, 0x25, 0xD3, 0x46, 0x65, 0xCD, 0x24, 0xC9, 0x6F, 0x42, 0xD3, 0x1F, 0x70, 0xAA, 0x8F,
+  0x42, 0x57, 0xE7, 0xA3, 0xF0, 0x13, 0x0F, 0x3F, 0x13, 0x84, 0xC8, 0x0D, 0xFC, 0x9A, 0x7C, 0xFF,
+  0xF2, 0xF9, 0x53, 0x8C, 0xEE, 0xA1, 0x5C, 0xD1, 0x8A, 0xE5, 0x86, 0xE4, 0x35, 0x27, 0x37, 0x6F,
+  0x11, 0xC4, 0xC9, 0x0C, 0xE3, 0x8C, 0x4C, 0x11, 0x9C, 0x00, 0x4F, 0x60, 0x5A, 0x2B, 0x61, 0xFD,
+  0xB0, 0xB8, 0xB3, 0x07, 0x67, 0x0D, 0x98, 0x48, 0x33, 0x2F, 0xBB, 0x70, 0x36, 0xD6, 0x81, 0xA1,
+  0xE4, 0xE3, 0x7C, 0x45, 0x6A, 0x64, 0xA9, 0x3B, 0xA1, 0x03, 0x8C, 0xD5, 0x00, 0x46, 0x52, 0x93,
+  0x34, 0x02, 0xFA, 0xEE, 0xAA, 0x30, 0x1C, 0x69, 0xD1, 0xD5, 0x29, 0xD0, 0x32, 0x70, 0x69, 0xDB,
+  0x74, 0x40, 0xE2, 0x06, 0x31, 0xFE, 0xB4, 0x04, 0x0D, 0x6D, 0xB4, 0xFE, 0x9D, 0xD6, 0x94, 0x28,
+  0xE3, 0x52, 0xDC, 0x28, 0xB9, 0xAD, 0xC3, 0x70, 0x9D, 0x53, 0x52, 0xB1, 0xCE, 0x7A, 0x9A, 0x09,
+  0x14, 0xBF, 0x65, 0xEA, 0x4D, 0xA1, 0x69, 0x34, 0x98, 0x5D, 0xDC, 0x33, 0x35, 0x9B, 0x55, 0xE7,
+  0x62, 0x42, 0x29, 0x6C, 0xD4, 0xB6, 0x51, 0xB2, 0x1E, 0x0F, 0xC3, 0x68, 0x28, 0x48, 0x68, 0xF0,
+  0x91, 0x92, 0xB5, 0x93, 0x22, 0x82, 0x44, 0xDA, 0x9E, 0x5E, 0x35, 0x5E, 0x04, 0x6A, 0x15, 0x62,
+  0xE0, 0x9B, 0x2D, 0xDB, 0x90, 0xE5, 0x72, 0xF1, 0x21, 0x90, 0x9A, 0x28, 0x39, 0x84, 0xD7, 0x64,
+  0xDB, 0xA0, 0x8A, 0xB9, 0x68, 0xF7, 0x23, 0x48, 0xC9, 0x11, 0x36, 0x4E, 0xB5, 0x83, 0x38, 0xD7,
+  0x90, 0xD3, 0xF7, 0xA7, 0x85, 0xCC, 0x4D, 0x4C, 0x75, 0x34, 0xF7, 0x4C, 0xA7, 0x39, 0x36, 0x51,
+  0xEC, 0xEE, 0xC5, 0x01, 0x5E, 0x71, 0xB2, 0xB8, 0xFF, 0xBA, 0x5E, 0x91, 0xEA, 0x3C, 0xBC, 0xDB,
+  0xB8, 0x14, 0xF6, 0x43, 0x1F, 0x2A, 0xEB, 0x9F, 0x40, 0xD7, 0x41, 0x39, 0xBF, 0xAD, 0xCE, 0x1E,
+  0x62, 0xF2, 0x86, 0xF5, 0xFF, 0xDD, 0xF2, 0xD3, 0xBA, 0x8C, 0xB6, 0x42, 0xF2, 0xBF, 0xE6, 0xBC,
+  0x56, 0x3C, 0x04, 0xDC, 0x6F, 0x80, 0x15, 0xFC, 0xC6, 0xBD, 0x39, 0xAD, 0xD0, 0x9A, 0x47, 0x43,
+  0xAA, 0xE7, 0x63, 0x86, 0x90, 0x07, 0x45, 0x39, 0x25, 0x29, 0xA2, 0x9E, 0x75, 0x0D, 0xC2, 0x07,
+  0x3B, 0xAC, 0xCB, 0x17, 0xA3, 0x21, 0xAD, 0x07, 0x34, 0xFC, 0xE2, 0x09, 0x25, 0xA5, 0x8C, 0xF6,
+  0x97, 0xA4, 0xAC, 0x87, 0x5F, 0x0E, 0x11, 0xD5, 0xF0, 0xFC, 0x0E, 0x1B, 0xAC, 0x12, 0x0E, 0xBF,
+  0x9B, 0xBC, 0xDB, 0x2B, 0x2D, 0x69, 0xE9, 0x40, 0x6F, 0x8A, 0x3D, 0xFD, 0x4B, 0x5F, 0x92, 0xDC,
+  0x84, 0x56, 0x18, 0x52, 0x47, 0x9F, 0xFE, 0xFD, 0x95, 0x19, 0x88, 0xE1, 0x0F, 0x5A, 0x51, 0xEB,
+  0x2E, 0x38, 0x03, 0x00, 0x00
+};
+
+#endif    // WiFiManager_NINA_Lite_HTML_h
@@ -0,0 +1,590 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Json.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  JSON export / import of Config Data and Dynamic Parameters for /config.json.
+  Must be included after WiFiNINA_Configuration, MenuItem and myMenuItems are declared.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Json_h
+#define WiFiManager_NINA_Lite_Json_h
+
+// New from v1.5.0
+// GET /config.json returns Config Data and all Dynamic Parameters in one object, with the same keys as Config Portal :
+//   {"id":"ssid0","pw":"pass0","id1":"ssid1","pw1":"pass1","nm":"board","svr":"io.adafruit.com","prt":1883}
+// POST /config.json with such an object (any subset of the keys) validates all of it first, then applies and saves it
+// with one saveConfigData(). Nothing is changed if any key is unknown or any value is invalid or too long.
+#ifndef USE_JSON_CONFIG_API
+  #define USE_JSON_CONFIG_API               false
+#endif
+
+#if USE_JSON_CONFIG_API
+
+#ifndef WM_JSON_MAX_TYPED_LEN
+  // Text form of a typed item value, such as "192.168.100.200" or an enum option name
+  #define WM_JSON_MAX_TYPED_LEN             31
+#endif
+
+// Pull tokenizer over a flat JSON object. Strings are decoded straight into the caller's buffer
+class WiFiNINA_JsonReader
+{
+  public:
+
+    WiFiNINA_JsonReader(const char* json, uint16_t length) : pos(json), end(json + length)
+    {
+    }
+
+    bool beginObject()
+    {
+      skipSpace();
+
+      return take('{');
+    }
+
+    // 1 : key read, 0 : end of object, -1 : syntax error
+    int8_t nextKey(char* key, uint8_t size)
+    {
+      skipSpace();
+
+      if (take('}'))
+        return 0;
+
+      if (!first && !take(','))
+        return -1;
+
+      first = false;
+
+      skipSpace();
+
+      if (readString(key, size) < 0)
+        return -1;
+
+      skipSpace();
+
+      if (!take(':'))
+        return -1;
+
+      return 1;
+    }
+
+    // String, number, true or false. Decoded into dest (if not NULL), truncated to size - 1 chars.
+    // Return the full decoded length, or -1 on syntax error
+    int readValue(char* dest, uint16_t size)
+    {
+      skipSpace();
+
+      if ( (pos < end) && (*pos == '"') )
+        return readString(dest, size);
+
+      // Literal : number, true or false
+      if ( (pos >= end) || !( isdigit((uint8_t) *pos) || (*pos == '-') || (*pos == 't') || (*pos == 'f') ) )
+        return -1;
+
+      uint16_t length = 0;
+
+      while ( (pos < end) && ( isalnum((uint8_t) *pos) || (*pos == '-') || (*pos == '+') || (*pos == '.') ) )
+      {
+        put(dest, size, length, *pos++);
+      }
+
+      terminate(dest, size, length);
+
+      return length;
+    }
+
+  private:
+
+    const char* pos;
+    const char* end;
+    bool        first = true;
+
+    void skipSpace()
+    {
+      while ( (pos < end) && ( (*pos == ' ') || (*pos == '\t') || (*pos == '\r') || (*pos == '\n') ) )
+        pos++;
+    }
+
+    bool take(char c)
+    {
+      if ( (pos < end) && (*pos == c) )
+      {
+        pos++;
+
+        return true;
+      }
+
+      return false;
+    }
+
+    static void put(char* dest, uint16_t size, uint16_t& length, char c)
+    {
+      if (dest && (length + 1 < size))
+        dest[length] = c;
+
+      length++;
+    }
+
+    static void terminate(char* dest, uint16_t size, uint16_t length)
+    {
+      if (dest && size)
+        dest[(length < size) ? length : size - 1] = 0;
+    }
+
+    static int hexValue(char c)
+    {
+      if ( (c >= '0') && (c <= '9') )
+        return c - '0';
+
+      c |= 0x20;
+
+      return ( (c >= 'a') && (c <= 'f') ) ? (c - 'a' + 10) : -1;
+    }
+
+    int readString(char* dest, uint16_t size)
+    {
+      uint16_t length = 0;
+
+      if (!take('"'))
+        return -1;
+
+      while (pos < end)
+      {
+        char c = *pos++;
+
+        if (c == '"')
+        {
+          terminate(dest, size, length);
+
+          return length;
+        }
+
+        if ( (uint8_t) c < 0x20 )
+          return -1;
+
+        if (c != '\\')
+        {
+          put(dest, size, length, c);
+          continue;
+        }
+
+        if (pos >= end)
+          return -1;
+
+        c = *pos++;
+
+        switch (c)
+        {
+          case '"':
+          case '\\':
+          case '/':
+            put(dest, size, length, c);
+            break;
+          case 'b':
+            put(dest, size, length, '\b');
+            break;
+          case 'f':
+            put(dest, size, length, '\f');
+            break;
+          case 'n':
+            put(dest, size, length, '\n');
+            break;
+          case 'r':
+            put(dest, size, length, '\r');
+            break;
+          case 't':
+            put(dest, size, length, '\t');
+            break;
+          case 'u':
+          {
+            uint16_t code = 0;
+
+            for (uint8_t i = 0; i < 4; i++)
+            {
+              int digit = (pos < end) ? hexValue(*pos++) : -1;
+
+              if (digit < 0)
+                return -1;
+
+              code = (code << 4) | digit;
+            }
+
+            // Surrogate pairs are not supported
+            if ( (code >= 0xD800) && (code <= 0xDFFF) )
+              return -1;
+
+            // UTF-8
+            if (code < 0x80)
+            {
+              put(dest, size, length, code);
+            }
+            else if (code < 0x800)
+            {
+              put(dest, size, length, 0xC0 | (code >> 6));
+              put(dest, size, length, 0x80 | (code & 0x3F));
+            }
+            else
+            {
+              put(dest, size, length, 0xE0 | (code >> 12));
+              put(dest, size, length, 0x80 | ((code >> 6) & 0x3F));
+              put(dest, size, length, 0x80 | (code & 0x3F));
+            }
+
+            break;
+          }
+          default:
+            return -1;
+        }
+      }
+
+      // Unterminated
+      return -1;
+    }
+};
+
+//////////////////////////////////////////////
+
+// Writer into a String, or only counting the length if there is none, to reserve the String first
+class WiFiNINA_JsonWriter
+{
+  public:
+
+    WiFiNINA_JsonWriter(String* out = NULL) : out(out)
+    {
+    }
+
+    void beginObject()
+    {
+      put('{');
+      first = true;
+    }
+
+    void endObject()
+    {
+      put('}');
+    }
+
+    void writeKey(const char* key)
+    {
+      if (!first)
+        put(',');
+
+      first = false;
+
+      writeString(key);
+      put(':');
+    }
+
+    void writeString(const char* text)
+    {
+      static const char hexDigits[] = "0123456789abcdef";
+
+      put('"');
+
+      while (*text)
+      {
+        uint8_t c = *text++;
+
+        if ( (c == '"') || (c == '\\') )
+        {
+          put('\\');
+          put(c);
+        }
+        else if (c < 0x20)
+        {
+          writeRaw("\\u00");
+          put(hexDigits[c >> 4]);
+          put(hexDigits[c & 0x0F]);
+        }
+        else
+        {
+          put(c);
+        }
+      }
+
+      put('"');
+    }
+
+    void writeRaw(const char* text)
+    {
+      while (*text)
+        put(*text++);
+    }
+
+    uint16_t length()
+    {
+      return count;
+    }
+
+  private:
+
+    String*   out;
+    uint16_t  count = 0;
+    bool      first = true;
+
+    void put(char c)
+    {
+      if (out)
+        *out += c;
+
+      count++;
+    }
+};
+
+//////////////////////////////////////////////
+
+#if USE_DYNAMIC_PARAMETERS
+// Position of the item with this id, or -1. Uses the Config Portal index if already built
+inline int WiFiNINA_menuItemPosition(const char* key)
+{
+  if (menuItemIndex)
+    return WiFiNINA_findMenuItem(myMenuItems, menuItemIndex, NUM_MENU_ITEMS, key);
+
+  for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+  {
+    if (!strcmp(myMenuItems[i].id, key))
+      return i;
+  }
+
+  return -1;
+}
+#endif
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_writeConfigJson(WiFiNINA_JsonWriter& writer, const WiFiNINA_Configuration& config)
+{
+  writer.beginObject();
+
+  writer.writeKey("id");
+  writer.writeString(config.WiFi_Creds[0].wifi_ssid);
+  writer.writeKey("pw");
+  writer.writeString(config.WiFi_Creds[0].wifi_pw);
+  writer.writeKey("id1");
+  writer.writeString(config.WiFi_Creds[1].wifi_ssid);
+  writer.writeKey("pw1");
+  writer.writeString(config.WiFi_Creds[1].wifi_pw);
+  writer.writeKey("nm");
+  writer.writeString(config.board_name);
+
+#if USE_STATIC_IP_CONFIG
+  static const char* const ipKeys[] = { "ip", "gw", "sn", "dns" };
+  const uint8_t*           ipFields[] = { config.staticIP.ip, config.staticIP.gateway, config.staticIP.subnet,
+                                          config.staticIP.dns };
+
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    writer.writeKey(ipKeys[i]);
+    writer.writeString(WiFiNINA_staticIPFieldToString(ipFields[i]).c_str());
+  }
+#endif
+
+#if USE_DYNAMIC_PARAMETERS
+  for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+  {
+    const MenuItem& item = myMenuItems[i];
+
+    writer.writeKey(item.id);
+
+    if (item.type == WM_ITEM_TEXT)
+    {
+      // Not always terminated if filled up to maxlen. Actual size of pdata is [maxlen + 1]
+      item.pdata[item.maxlen] = 0;
+      writer.writeString(item.pdata);
+
+      continue;
+    }
+
+    String value = WiFiNINA_menuItemToString(item);
+
+    if (item.type == WM_ITEM_BOOL)
+      writer.writeRaw( (value == "1") ? "true" : "false" );
+    else if ( ( (item.type == WM_ITEM_UINT16) || (item.type == WM_ITEM_INT32) || (item.type == WM_ITEM_FLOAT) )
+              && (isdigit((uint8_t) value[0]) || ( (value[0] == '-') && isdigit((uint8_t) value[1]) ) ) )
+      writer.writeRaw(value.c_str());
+    else
+      writer.writeString(value.c_str());
+  }
+#endif
+
+  writer.endObject();
+}
+
+//////////////////////////////////////////////
+
+inline String WiFiNINA_configToJson(const WiFiNINA_Configuration& config)
+{
+  // Count first, so that the String is allocated once
+  WiFiNINA_JsonWriter counter;
+
+  WiFiNINA_writeConfigJson(counter, config);
+
+  String json;
+
+  json.reserve(counter.length());
+
+  WiFiNINA_JsonWriter writer(&json);
+
+  WiFiNINA_writeConfigJson(writer, config);
+
+  return json;
+}
+
+//////////////////////////////////////////////
+
+// One pass over the document. With apply = false, only validates. errorKey[MAX_ID_LEN + 2] gets the offending key,
+// or "" for a syntax error
+inline bool WiFiNINA_parseConfigJson(const char* json, uint16_t length, WiFiNINA_Configuration& config, bool apply,
+                                     char* errorKey)
+{
+  WiFiNINA_JsonReader reader(json, length);
+  int8_t              result;
+
+  errorKey[0] = 0;
+
+  if (!reader.beginObject())
+    return false;
+
+  // One more than the longest id, so that a longer key never matches
+  while ( (result = reader.nextKey(errorKey, MAX_ID_LEN + 2)) > 0 )
+  {
+    char*     field     = NULL;
+    uint16_t  fieldSize = 0;
+
+    uint8_t builtinKey = WiFiNINA_builtinKey(errorKey);
+
+#if USE_STATIC_IP_CONFIG
+    uint8_t* octet = WiFiNINA_staticIPField(config.staticIP, builtinKey);
+
+    if (octet)
+    {
+      char value[16];
+      int  valueLength = reader.readValue(value, sizeof(value));
+
+      if ( (valueLength < 0) || (valueLength > 15) )
+        return false;
+
+      uint8_t scratch[4];
+
+      if (!WiFiNINA_setStaticIPField(apply ? octet : scratch, value))
+        return false;
+
+      continue;
+    }
+#endif
+
+    switch (builtinKey)
+    {
+      case WM_KEY_ID:
+        field     = config.WiFi_Creds[0].wifi_ssid;
+        fieldSize = sizeof(config.WiFi_Creds[0].wifi_ssid);
+        break;
+      case WM_KEY_PW:
+        field     = config.WiFi_Creds[0].wifi_pw;
+        fieldSize = sizeof(config.WiFi_Creds[0].wifi_pw);
+        break;
+      case WM_KEY_ID1:
+        field     = config.WiFi_Creds[1].wifi_ssid;
+        fieldSize = sizeof(config.WiFi_Creds[1].wifi_ssid);
+        break;
+      case WM_KEY_PW1:
+        field     = config.WiFi_Creds[1].wifi_pw;
+        fieldSize = sizeof(config.WiFi_Creds[1].wifi_pw);
+        break;
+      case WM_KEY_NM:
+        field     = config.board_name;
+        fieldSize = sizeof(config.board_name);
+        break;
+    }
+
+    if (field)
+    {
+      // Same limit as Config Portal, fieldSize - 1 chars
+      int valueLength = reader.readValue(apply ? field : NULL, fieldSize);
+
+      if ( (valueLength < 0) || (valueLength > fieldSize - 1) )
+        return false;
+
+      continue;
+    }
+
+#if USE_DYNAMIC_PARAMETERS
+    int position = WiFiNINA_menuItemPosition(errorKey);
+
+    if (position >= 0)
+    {
+      const MenuItem& item = myMenuItems[position];
+
+      if (item.type == WM_ITEM_TEXT)
+      {
+        if (apply)
+          WiFiNINA_clearMenuItem(item);
+
+        int valueLength = reader.readValue(apply ? item.pdata : NULL, item.maxlen + 1);
+
+        if ( (valueLength < 0) || (valueLength > item.maxlen) )
+          return false;
+      }
+      else
+      {
+        char value[WM_JSON_MAX_TYPED_LEN + 1];
+        int  valueLength = reader.readValue(value, sizeof(value));
+
+        if ( (valueLength < 0) || (valueLength > WM_JSON_MAX_TYPED_LEN) )
+          return false;
+
+        // Validate into a scratch copy, all typed items are 4 bytes or less
+        uint32_t  scratch;
+        MenuItem  probe = item;
+
+        probe.pdata = (char *) &scratch;
+
+        if (!WiFiNINA_setMenuItem(apply ? item : probe, value))
+          return false;
+      }
+
+      continue;
+    }
+#endif
+
+    // Unknown key
+    return false;
+  }
+
+  if (result < 0)
+  {
+    errorKey[0] = 0;
+
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////
+
+inline String WiFiNINA_jsonError(const char* key)
+{
+  String              json;
+  WiFiNINA_JsonWriter writer(&json);
+
+  writer.beginObject();
+  writer.writeKey("error");
+  writer.writeString(key[0] ? "invalid" : "syntax");
+  writer.writeKey("key");
+  writer.writeString(key);
+  writer.endObject();
+
+  return json;
+}
+
+#endif    // USE_JSON_CONFIG_API
+
+#endif    // WiFiManager_NINA_Lite_Json_h
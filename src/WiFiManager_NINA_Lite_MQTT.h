@@ -0,0 +1,1616 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_MQTT.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Adafruit_MQTT_Client for WiFiNINA, reading the socket in bulk.
+  Not included by the board headers. Include in the sketch using Adafruit_MQTT_Library
+  (https://github.com/adafruit/Adafruit_MQTT_Library), with the patched Adafruit_MQTT.cpp of LibraryPatches.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_MQTT_h
+#define WiFiManager_NINA_Lite_MQTT_h
+
+#include "Adafruit_MQTT.h"
+#include "Adafruit_MQTT_Client.h"
+
+#include <WiFiManager_NINA_Lite_Debug.h>
+#include <WiFiManager_NINA_Lite_Backoff.h>
+#include <WiFiManager_NINA_Lite_Service.h>
+#include <WiFiManager_NINA_Lite_Spool.h>
+
+#ifndef WM_MQTT_RX_BUFFER_SIZE
+  // Receive buffer. Holds all the bytes available in the socket, up to this size, after one read
+  #define WM_MQTT_RX_BUFFER_SIZE            256
+#endif
+
+// Bytes of a packet larger than the receive buffer to have before handling it. The rest is dropped
+#define WM_MQTT_OVERSIZE_KEPT             ( (MAXBUFFERSIZE - 1 < WM_MQTT_RX_BUFFER_SIZE) ? MAXBUFFERSIZE - 1 : WM_MQTT_RX_BUFFER_SIZE )
+
+#ifndef MQTT_CLIENT_READINTERVAL_MS
+  #define MQTT_CLIENT_READINTERVAL_MS       10
+#endif
+
+#ifndef WM_MQTT_MAX_PACKETS_PER_CALL
+  // processPackets() returns after this many packets, even within its timeout, so that loop() goes on under a flood
+  #define WM_MQTT_MAX_PACKETS_PER_CALL      16
+#endif
+
+// New from v1.5.0
+// publishAsync() sends a QoS 1 message without waiting for its PUBACK, so that a burst goes out at line rate instead of
+// one message per broker round trip. Up to WM_MQTT_PUBLISH_WINDOW messages wait for their PUBACK, each in a slot of
+// WM_MQTT_PUBLISH_PACKET_SIZE bytes, and are sent again by processPackets() if not acknowledged in time.
+#ifndef USE_MQTT_ASYNC_PUBLISH
+  #define USE_MQTT_ASYNC_PUBLISH            false
+#endif
+
+#if USE_MQTT_ASYNC_PUBLISH
+
+#ifndef WM_MQTT_PUBLISH_WINDOW
+  // Max messages waiting for their PUBACK
+  #define WM_MQTT_PUBLISH_WINDOW            4
+#endif
+
+#ifndef WM_MQTT_PUBLISH_PACKET_SIZE
+  // Max bytes of a whole PUBLISH packet, header, topic and payload
+  #define WM_MQTT_PUBLISH_PACKET_SIZE       MAXBUFFERSIZE
+#endif
+
+#ifndef WM_MQTT_RETRANSMIT_MS
+  // ms. Wait for a PUBACK before sending the message again, with DUP
+  #define WM_MQTT_RETRANSMIT_MS             2000L
+#endif
+
+#ifndef WM_MQTT_RETRANSMIT_TRIES
+  // Sends again before giving up on the message
+  #define WM_MQTT_RETRANSMIT_TRIES          3
+#endif
+
+typedef struct
+{
+  uint32_t  sent;             // publishAsync() messages sent
+  uint32_t  acked;            // PUBACKs matched
+  uint32_t  retransmitted;    // Sends again, with DUP
+  uint32_t  dropped;          // Given up after WM_MQTT_RETRANSMIT_TRIES
+} WiFiNINA_MQTT_PublishStats;
+
+#endif    // USE_MQTT_ASYNC_PUBLISH
+
+#ifndef WM_MQTT_TOPIC_MAX_LEN
+  // Max topic length of WiFiNINA_MQTT_Topic, whose packet header is kept in the object
+  #define WM_MQTT_TOPIC_MAX_LEN             64
+#endif
+
+#ifndef WM_MQTT_TOPIC_INLINE_PAYLOAD
+  // Payloads up to this size are sent with the header of WiFiNINA_MQTT_Topic in one client write, as each write is an
+  // SPI transaction, and often a TCP segment. Larger ones are written straight from the caller's memory
+  #define WM_MQTT_TOPIC_INLINE_PAYLOAD      16
+#endif
+
+#ifndef WM_MQTT_WRITE_CHUNK
+  // Max bytes per client write, as Adafruit_MQTT_Client::sendPacket()
+  #define WM_MQTT_WRITE_CHUNK               250
+#endif
+
+//////////////////////////////////////////////
+
+// Encode MQTT Remaining Length in 1 to 4 bytes. Return the bytes written
+inline uint8_t WiFiNINA_MQTT_encodeLength(uint8_t* p, uint32_t length)
+{
+  uint8_t count = 0;
+
+  do
+  {
+    uint8_t encodedByte = length % 128;
+
+    length /= 128;
+
+    p[count++] = (length > 0) ? (encodedByte | 0x80) : encodedByte;
+  } while (length > 0);
+
+  return count;
+}
+
+//////////////////////////////////////////////
+
+// Fixed header of a PUBLISH packet, put in head just before its topic at head[topicStart], with room for 5 bytes.
+// Return the index of its first byte
+inline uint8_t WiFiNINA_MQTT_putPublishHeader(uint8_t* head, uint8_t topicStart, uint8_t qos, uint32_t remaining)
+{
+  uint8_t length[4];
+  uint8_t lengthLen = WiFiNINA_MQTT_encodeLength(length, remaining);
+  uint8_t start     = topicStart - 1 - lengthLen;
+
+  head[start] = (MQTT_CTRL_PUBLISH << 4) | (qos > 0 ? (MQTT_QOS_1 << 1) : 0);
+  memcpy(head + start + 1, length, lengthLen);
+
+  return start;
+}
+
+//////////////////////////////////////////////
+
+// New from v1.5.0
+// Adafruit_MQTT_Client::readPacket() takes each byte with its own available() and read(), that is 2 SPI transactions to
+// the WiFiNINA module per byte. Here, all the bytes available are taken with one read() into a receive buffer, and the
+// packets are then served from it, whether they arrived in pieces or several in one segment.
+// Use instead of Adafruit_MQTT_Client, with the same constructors.
+class WiFiNINA_MQTT_Client : public Adafruit_MQTT_Client
+{
+  public:
+
+    WiFiNINA_MQTT_Client(Client *client, const char *server, uint16_t port, const char *cid, const char *user,
+                         const char *pass) : Adafruit_MQTT_Client(client, server, port, cid, user, pass), netClient(client)
+    {
+    }
+
+    WiFiNINA_MQTT_Client(Client *client, const char *server, uint16_t port, const char *user = "", const char *pass = "")
+      : Adafruit_MQTT_Client(client, server, port, user, pass), netClient(client)
+    {
+    }
+
+    bool connectServer()
+    {
+      // Bytes of a previous connection are not for this one
+      rxStart = rxEnd = 0;
+      rxSkip  = 0;
+
+#if USE_MQTT_ASYNC_PUBLISH
+      // Messages not acknowledged in the previous connection are sent again as soon as processPackets() runs
+      for (uint8_t i = 0; i < WM_MQTT_PUBLISH_WINDOW; i++)
+      {
+        pending[i].sentTime = millis() - WM_MQTT_RETRANSMIT_MS;
+      }
+#endif
+
+      return Adafruit_MQTT_Client::connectServer();
+    }
+
+    // As Adafruit_MQTT_Client::readPacket() : up to maxlen bytes, waiting up to timeout ms for each more byte
+    uint16_t readPacket(uint8_t *buffer, uint16_t maxlen, int16_t timeout)
+    {
+      uint16_t  len     = 0;
+      int16_t   waited  = 0;
+
+      while (len < maxlen)
+      {
+        if (rxStart == rxEnd)
+        {
+          // Large rest of a packet, straight into buffer. Not while the rest of an oversize packet is being dropped
+          if ( (maxlen - len >= WM_MQTT_RX_BUFFER_SIZE) && (rxSkip == 0) && (netClient->available() > 0) )
+          {
+            int rlen = netClient->read(buffer + len, maxlen - len);
+
+            if (rlen > 0)
+            {
+              len    += rlen;
+              waited  = 0;
+              continue;
+            }
+          }
+          else if (fill())
+          {
+            waited = 0;
+            continue;
+          }
+
+          if ( (waited > timeout) || !netClient->connected() )
+            break;
+
+          waited += MQTT_CLIENT_READINTERVAL_MS;
+          delay(MQTT_CLIENT_READINTERVAL_MS);
+
+          continue;
+        }
+
+        uint16_t size = rxEnd - rxStart;
+
+        if (size > maxlen - len)
+          size = maxlen - len;
+
+        memcpy(buffer + len, rx + rxStart, size);
+
+        rxStart += size;
+        len     += size;
+      }
+
+      return len;
+    }
+
+    // Length of the first packet if it's all in the receive buffer, after taking the bytes available, else 0.
+    // A packet larger than the receive buffer counts once what readFrame() keeps of it is there. Doesn't wait
+    uint32_t frameAvailable()
+    {
+      fill();
+
+      return bufferedFrame();
+    }
+
+    // As frameAvailable(), from the bytes already in the receive buffer only
+    uint32_t bufferedFrame()
+    {
+      uint32_t  length      = 0;
+      uint32_t  multiplier  = 1;
+      uint16_t  index       = rxStart + 1;
+
+      // Remaining length, 1 to 4 bytes after the packet type
+      while (true)
+      {
+        if (index >= rxEnd)
+          return 0;
+
+        uint8_t encodedByte = rx[index++];
+
+        length += (encodedByte & 0x7F) * multiplier;
+
+        if ( !(encodedByte & 0x80) )
+          break;
+
+        multiplier *= 128;
+
+        if (multiplier > (128UL * 128UL * 128UL))
+        {
+          // Malformed. Let readPacket() reject it
+          return rxEnd - rxStart;
+        }
+      }
+
+      uint32_t frameLength = (index - rxStart) + length;
+
+      // Never all in the receive buffer. Only its start is kept, see readFrame()
+      if ( (frameLength > WM_MQTT_RX_BUFFER_SIZE) && (rxEnd - rxStart >= WM_MQTT_OVERSIZE_KEPT) )
+        return frameLength;
+
+      return ( (uint32_t) (rxEnd - rxStart) >= frameLength) ? frameLength : 0;
+    }
+
+    // As Adafruit_MQTT::processPackets() : call the callbacks of the messages received in timeout ms. Whole packets are
+    // taken from the receive buffer, so that timeout 0 doesn't wait. Call processPackets(0) in each loop(), instead of
+    // readSubscription(5000), to get messages as they come without stalling loop(). Also matches the PUBACKs of
+    // publishAsync()
+    void processPackets(int16_t timeout = 0)
+    {
+      unsigned long startTime = millis();
+      uint16_t      packets   = 0;
+
+      while (true)
+      {
+        // One available() and read() for all the packets they bring. Whole packets are taken without waiting, but at
+        // most WM_MQTT_MAX_PACKETS_PER_CALL
+        fill();
+
+        while ( (packets < WM_MQTT_MAX_PACKETS_PER_CALL) && processBuffered() )
+        {
+          packets++;
+        }
+
+#if USE_MQTT_ASYNC_PUBLISH
+        retransmit();
+#endif
+
+        if ( (millis() - startTime >= (unsigned long) timeout) || (packets >= WM_MQTT_MAX_PACKETS_PER_CALL) ||
+             !netClient->connected() )
+          break;
+
+        delay(MQTT_CLIENT_READINTERVAL_MS);
+      }
+    }
+
+    // Take one packet from the receive buffer, as processPackets(). Return false, without waiting, if none is complete
+    bool processNext()
+    {
+      fill();
+
+      return processBuffered();
+    }
+
+    // As processNext(), without taking more bytes from the client
+    bool processBuffered()
+    {
+      uint32_t length = bufferedFrame();
+
+      if (length == 0)
+        return false;
+
+      handleFrame(readFrame(length));
+
+      return true;
+    }
+
+    // As Adafruit_MQTT::setKeepAliveInterval(). The keep alive of Adafruit_MQTT is private, so it's kept here for
+    // startConnect() and the pings of WiFiNINA_MQTT_Service, and set in both at once
+    bool setKeepAliveInterval(uint16_t keepAlive)
+    {
+      if (!Adafruit_MQTT::setKeepAliveInterval(keepAlive))
+        return false;
+
+      connectKeepAlive = keepAlive;
+
+      return true;
+    }
+
+    uint16_t getKeepAliveInterval()
+    {
+      return connectKeepAlive;
+    }
+
+    // Open the connection and send CONNECT, as Adafruit_MQTT::connect(), without waiting for CONNACK.
+    // Only opening the connection waits, in the WiFiNINA firmware
+    bool startConnect()
+    {
+      if (!connectServer())
+        return false;
+
+      // Variable header and payload after the room for the fixed header, as connectPacket()
+      uint8_t*  p = buffer + 5;
+
+#if MQTT_PROTOCOL_LEVEL == 3
+      p = putString(p, "MQIsdp", 6);
+#else
+      p = putString(p, "MQTT", 4);
+#endif
+
+      *p++ = MQTT_PROTOCOL_LEVEL;
+
+      uint8_t* flags  = p++;
+      bool     will   = (will_topic && (will_topic[0] != 0));
+
+      *flags = MQTT_CONN_CLEANSESSION;
+
+      if (will)
+      {
+        *flags |= MQTT_CONN_WILLFLAG;
+
+        if (will_qos == 1)
+          *flags |= MQTT_CONN_WILLQOS_1;
+        else if (will_qos == 2)
+          *flags |= MQTT_CONN_WILLQOS_2;
+
+        if (will_retain == 1)
+          *flags |= MQTT_CONN_WILLRETAIN;
+      }
+
+      if (username[0] != 0)
+        *flags |= MQTT_CONN_USERNAMEFLAG;
+
+      if (password[0] != 0)
+        *flags |= MQTT_CONN_PASSWORDFLAG;
+
+      *p++ = connectKeepAlive >> 8;
+      *p++ = connectKeepAlive & 0xFF;
+
+      uint16_t length = strlen(clientid);
+
+#if MQTT_PROTOCOL_LEVEL == 3
+      // Client ID limited to 23 chars
+      if (length > 23)
+        length = 23;
+#endif
+
+      if ( (p - buffer) + 2 + length + (will ? 4 + strlen(will_topic) + strlen(will_payload) : 0)
+           + 2 + strlen(username) + 2 + strlen(password) > MAXBUFFERSIZE )
+      {
+        return false;
+      }
+
+      p = putString(p, clientid, length);
+
+      if (will)
+      {
+        p = putString(p, will_topic, strlen(will_topic));
+        p = putString(p, will_payload, strlen(will_payload));
+      }
+
+      if (username[0] != 0)
+        p = putString(p, username, strlen(username));
+
+      if (password[0] != 0)
+        p = putString(p, password, strlen(password));
+
+      // Fixed header just before
+      uint8_t   lengthBytes[4];
+      uint8_t   lengthLen = WiFiNINA_MQTT_encodeLength(lengthBytes, p - (buffer + 5));
+      uint8_t*  start     = buffer + 5 - 1 - lengthLen;
+
+      start[0] = MQTT_CTRL_CONNECT << 4;
+      memcpy(start + 1, lengthBytes, lengthLen);
+
+      return sendPacket(start, p - start);
+    }
+
+    // Send SUBSCRIBE, as Adafruit_MQTT::connect() does, without waiting for SUBACK. packetId is set to its identifier
+    bool sendSubscribe(const char *topic, uint8_t qos, uint16_t& packetId)
+    {
+      uint16_t topicLen = strlen(topic);
+
+      if (2 + 2 + 2 + topicLen + 1 > MAXBUFFERSIZE)
+        return false;
+
+      packetId = nextPacketId();
+
+      uint8_t* p = buffer;
+
+      *p++ = (MQTT_CTRL_SUBSCRIBE << 4) | (MQTT_QOS_1 << 1);
+      p   += WiFiNINA_MQTT_encodeLength(p, 2 + 2 + topicLen + 1);
+      *p++ = packetId >> 8;
+      *p++ = packetId & 0xFF;
+      p    = putString(p, topic, topicLen);
+      *p++ = qos;
+
+      return sendPacket(buffer, p - buffer);
+    }
+
+    bool sendPing()
+    {
+      uint8_t packet[2] = { MQTT_CTRL_PINGREQ << 4, 0 };
+
+      return sendPacket(packet, sizeof(packet));
+    }
+
+    // Type of the last CONNACK, SUBACK, UNSUBACK or PINGRESP taken, 0 if none since clearReply()
+    uint8_t replyType()
+    {
+      return lastReplyType;
+    }
+
+    // Up to 3 bytes after the fixed header of the last reply, such as CONNACK flags and return code
+    const uint8_t* replyData()
+    {
+      return lastReplyData;
+    }
+
+    void clearReply()
+    {
+      lastReplyType = 0;
+    }
+
+    // Packet identifier for the next QoS 1 message, as Adafruit_MQTT::publish(). Never 0, nor one still waiting for its
+    // PUBACK
+    uint16_t nextPacketId()
+    {
+      uint16_t packetId;
+
+      do
+      {
+        packetId = packet_id_counter++;
+      }
+#if USE_MQTT_ASYNC_PUBLISH
+      while ( (packetId == 0) || (findSlot(packetId) >= 0) );
+#else
+      while (packetId == 0);
+#endif
+
+      return packetId;
+    }
+
+    // Send a packet whose header is in head, then its payload, each with one client write per WM_MQTT_WRITE_CHUNK
+    // bytes, without copying them into buffer
+    bool writePacket(const uint8_t *head, uint16_t headLen, const uint8_t *payload, uint16_t bLen)
+    {
+      return writeAll(head, headLen) && writeAll(payload, bLen);
+    }
+
+    // Take the packets received, as processPackets(), until the PUBACK of packetId, up to timeout ms
+    bool waitPubAck(uint16_t packetId, int16_t timeout)
+    {
+      unsigned long startTime = millis();
+
+      lastPubAck = 0;
+
+      while (lastPubAck != packetId)
+      {
+        if (processNext())
+          continue;
+
+        if ( (millis() - startTime >= (unsigned long) timeout) || !netClient->connected() )
+          return false;
+
+        delay(MQTT_CLIENT_READINTERVAL_MS);
+      }
+
+      return true;
+    }
+
+#if USE_MQTT_ASYNC_PUBLISH
+
+    // Send a QoS 1 message without waiting for its PUBACK. Return false if the window is still full after taking the
+    // packets received, if the packet is larger than WM_MQTT_PUBLISH_PACKET_SIZE, or if the send fails.
+    // Don't mix with publish() QoS 1 or ping(), which drop the PUBACKs they don't wait for. Those messages are then
+    // sent again
+    bool publishAsync(const char *topic, const uint8_t *payload, uint16_t bLen)
+    {
+      return publishAsync(topic, strlen(topic), payload, bLen);
+    }
+
+    bool publishAsync(const char *topic, const char *payload)
+    {
+      return publishAsync(topic, strlen(topic), (const uint8_t *) payload, strlen(payload));
+    }
+
+    bool publishAsync(const char *topic, uint16_t topicLen, const uint8_t *payload, uint16_t bLen)
+    {
+      uint32_t  remaining = 2 + topicLen + 2 + bLen;
+
+      if (1 + 4 + remaining > WM_MQTT_PUBLISH_PACKET_SIZE)
+        return false;
+
+      int8_t slot = freeSlot();
+
+      if (slot < 0)
+      {
+        processPackets(0);
+
+        if ( (slot = freeSlot()) < 0)
+          return false;
+      }
+
+      uint16_t packetId = nextPacketId();
+      uint8_t* p        = pending[slot].packet;
+
+      *p++ = (MQTT_CTRL_PUBLISH << 4) | (MQTT_QOS_1 << 1);
+      p   += WiFiNINA_MQTT_encodeLength(p, remaining);
+
+      *p++ = topicLen >> 8;
+      *p++ = topicLen & 0xFF;
+      memcpy(p, topic, topicLen);
+      p += topicLen;
+
+      *p++ = packetId >> 8;
+      *p++ = packetId & 0xFF;
+
+      memcpy(p, payload, bLen);
+      p += bLen;
+
+      pending[slot].length = p - pending[slot].packet;
+
+      if (!sendPacket(pending[slot].packet, pending[slot].length))
+        return false;
+
+      pending[slot].packetId  = packetId;
+      pending[slot].sentTime  = millis();
+      pending[slot].tries     = 0;
+
+      publishStatistics.sent++;
+
+      return true;
+    }
+
+    // Messages waiting for their PUBACK
+    uint8_t inFlight()
+    {
+      uint8_t count = 0;
+
+      for (uint8_t i = 0; i < WM_MQTT_PUBLISH_WINDOW; i++)
+      {
+        if (pending[i].packetId)
+          count++;
+      }
+
+      return count;
+    }
+
+    const WiFiNINA_MQTT_PublishStats& publishStats()
+    {
+      return publishStatistics;
+    }
+
+#endif    // USE_MQTT_ASYNC_PUBLISH
+
+  protected:
+
+    Client*   netClient;
+
+    uint8_t   rx[WM_MQTT_RX_BUFFER_SIZE];
+    uint16_t  rxStart = 0;
+    uint16_t  rxEnd   = 0;
+
+    // Bytes of an oversize packet still to come, dropped as they arrive
+    uint32_t  rxSkip  = 0;
+
+    uint16_t  lastPubAck = 0;
+
+    // Keep alive sent in CONNECT, in s
+    uint16_t  connectKeepAlive = MQTT_CONN_KEEPALIVE;
+
+    uint8_t   lastReplyType = 0;
+    uint8_t   lastReplyData[3];
+
+    static uint8_t* putString(uint8_t* p, const char* text, uint16_t length)
+    {
+      *p++ = length >> 8;
+      *p++ = length & 0xFF;
+      memcpy(p, text, length);
+
+      return p + length;
+    }
+
+    bool writeAll(const uint8_t *data, uint16_t len)
+    {
+      while (len > 0)
+      {
+        uint16_t sendLen = (len > WM_MQTT_WRITE_CHUNK) ? WM_MQTT_WRITE_CHUNK : len;
+
+        if ( !netClient->connected() || (netClient->write(data, sendLen) != sendLen) )
+          return false;
+
+        data  += sendLen;
+        len   -= sendLen;
+      }
+
+      return true;
+    }
+
+    // Take all the bytes available, up to the free space, with one read(). Return false if none.
+    // The rest of an oversize packet is dropped here, as it comes
+    bool fill()
+    {
+      if (rxStart > 0)
+      {
+        memmove(rx, rx + rxStart, rxEnd - rxStart);
+        rxEnd   -= rxStart;
+        rxStart  = 0;
+      }
+
+      if ( (rxEnd == WM_MQTT_RX_BUFFER_SIZE) || (netClient->available() <= 0) )
+        return false;
+
+      int rlen = netClient->read(rx + rxEnd, WM_MQTT_RX_BUFFER_SIZE - rxEnd);
+
+      if (rlen <= 0)
+        return false;
+
+      rxEnd += rlen;
+
+      if (rxSkip > 0)
+      {
+        uint16_t drop = (rxSkip < (uint32_t) rlen) ? rxSkip : rlen;
+
+        memmove(rx, rx + drop, rxEnd - drop);
+        rxEnd   -= drop;
+        rxSkip  -= drop;
+      }
+
+      return true;
+    }
+
+    // Take a packet of length bytes, from bufferedFrame(), from the receive buffer into buffer. Its end is dropped if
+    // larger than buffer, as by readFullPacket(), and the rest of an oversize packet by later fill(), without waiting.
+    // Return the bytes in buffer
+    uint16_t readFrame(uint32_t length)
+    {
+      uint16_t inRx = rxEnd - rxStart;
+      uint16_t len  = (length <= MAXBUFFERSIZE) ? length : MAXBUFFERSIZE - 1;
+
+      if (len > inRx)
+        len = inRx;
+
+      memcpy(buffer, rx + rxStart, len);
+
+      if (length > inRx)
+      {
+        rxSkip   = length - inRx;
+        rxStart  = rxEnd;
+      }
+      else
+      {
+        rxStart += length;
+      }
+
+      return len;
+    }
+
+    void handleFrame(uint16_t len)
+    {
+      if (len < 2)
+        return;
+
+      uint8_t packetType = buffer[0] >> 4;
+
+      if ( (packetType == MQTT_CTRL_PUBACK) && (len >= 4) )
+      {
+        lastPubAck = (buffer[2] << 8) | buffer[3];
+
+#if USE_MQTT_ASYNC_PUBLISH
+        int8_t slot = findSlot(lastPubAck);
+
+        if (slot >= 0)
+        {
+          pending[slot].packetId = 0;
+          publishStatistics.acked++;
+        }
+#endif
+
+        return;
+      }
+
+      if ( (packetType == MQTT_CTRL_CONNECTACK) || (packetType == MQTT_CTRL_SUBACK) ||
+           (packetType == MQTT_CTRL_UNSUBACK) || (packetType == MQTT_CTRL_PINGRESP) )
+      {
+        lastReplyType = packetType;
+        memcpy(lastReplyData, buffer + 2, (len - 2 < 3) ? len - 2 : 3);
+
+        return;
+      }
+
+      if (packetType != MQTT_CTRL_PUBLISH)
+        return;
+
+      Adafruit_MQTT_Subscribe *sub = handleSubscriptionPacket(len);
+
+      // Kept unread, for readSubscription(), if the subscription has no callback
+      if ( !sub || ( (sub->callback_uint32t == NULL) && (sub->callback_double == NULL) &&
+                     (sub->callback_buffer == NULL) && (sub->callback_io == NULL) ) )
+      {
+        return;
+      }
+
+      sub->new_message = false;
+
+      // As Adafruit_MQTT::processPackets()
+      if (sub->callback_uint32t != NULL)
+      {
+        sub->callback_uint32t(atoi((char *) sub->lastread));
+      }
+      else if (sub->callback_double != NULL)
+      {
+        sub->callback_double(atof((char *) sub->lastread));
+      }
+      else if (sub->callback_buffer != NULL)
+      {
+        sub->callback_buffer((char *) sub->lastread, sub->datalen);
+      }
+      else if (sub->callback_io != NULL)
+      {
+        ((sub->io_mqtt)->*(sub->callback_io))((char *) sub->lastread, sub->datalen);
+      }
+    }
+
+#if USE_MQTT_ASYNC_PUBLISH
+
+    typedef struct
+    {
+      uint16_t      packetId;         // 0 if the slot is free
+      uint16_t      length;
+      unsigned long sentTime;
+      uint8_t       tries;
+      uint8_t       packet[WM_MQTT_PUBLISH_PACKET_SIZE];
+    } WiFiNINA_MQTT_Pending;
+
+    WiFiNINA_MQTT_Pending       pending[WM_MQTT_PUBLISH_WINDOW] = {};
+    WiFiNINA_MQTT_PublishStats  publishStatistics = {};
+
+    int8_t findSlot(uint16_t packetId)
+    {
+      for (uint8_t i = 0; i < WM_MQTT_PUBLISH_WINDOW; i++)
+      {
+        if (pending[i].packetId == packetId)
+          return i;
+      }
+
+      return -1;
+    }
+
+    int8_t freeSlot()
+    {
+      return findSlot(0);
+    }
+
+    // Send again, with DUP, the messages not acknowledged in WM_MQTT_RETRANSMIT_MS
+    void retransmit()
+    {
+      for (uint8_t i = 0; i < WM_MQTT_PUBLISH_WINDOW; i++)
+      {
+        if ( !pending[i].packetId || (millis() - pending[i].sentTime < WM_MQTT_RETRANSMIT_MS) )
+          continue;
+
+        if (pending[i].tries >= WM_MQTT_RETRANSMIT_TRIES)
+        {
+          pending[i].packetId = 0;
+          publishStatistics.dropped++;
+
+          continue;
+        }
+
+        pending[i].packet[0] |= 0x08;
+        pending[i].sentTime   = millis();
+        pending[i].tries++;
+
+        if (sendPacket(pending[i].packet, pending[i].length))
+          publishStatistics.retransmitted++;
+      }
+    }
+
+#endif    // USE_MQTT_ASYNC_PUBLISH
+};
+
+//////////////////////////////////////////////
+
+// WiFiNINA_MQTT_Service states
+#define WM_MQTT_DISCONNECTED                0     // Waiting for WiFi, or for the next try
+#define WM_MQTT_CONNECTING                  1     // CONNECT sent, waiting for CONNACK
+#define WM_MQTT_SUBSCRIBING                 2     // SUBSCRIBE sent, waiting for SUBACK
+#define WM_MQTT_CONNECTED                   3
+
+#ifndef WM_MQTT_RECONNECT_BASE_DELAY
+  // ms. Min wait between broker connect tries, as WiFiNINA_Backoff
+  #define WM_MQTT_RECONNECT_BASE_DELAY      5000L
+#endif
+
+#ifndef WM_MQTT_RECONNECT_MAX_DELAY
+  // ms. Max wait between broker connect tries
+  #define WM_MQTT_RECONNECT_MAX_DELAY       60000L
+#endif
+
+#ifndef WM_MQTT_REPLY_TIMEOUT
+  // ms. Wait for CONNACK, SUBACK or PINGRESP before closing the connection and trying again later
+  #define WM_MQTT_REPLY_TIMEOUT             CONNECT_TIMEOUT_MS
+#endif
+
+// New from v1.5.0
+// Keeps the MQTT session of a WiFiNINA_MQTT_Client from run(), instead of the sketch calling connect(), subscribe and
+// ping(), which wait for the broker, and waiting between tries. Each run() takes one step : connect when WiFi is
+// connected, subscribe, ping every half keep alive interval, and close and try again with backoff when the broker
+// doesn't answer. The packets received are taken within the time slice of run(), calling the subscription callbacks.
+// Needs #define USE_RUN_SERVICES true, then WiFiManager_NINA->addService(mqttService)
+class WiFiNINA_MQTT_Service : public WiFiNINA_Service
+{
+  public:
+
+    WiFiNINA_MQTT_Service(WiFiNINA_MQTT_Client *mqttClient) : mqtt(mqttClient)
+    {
+      backoff.setDelays(WM_MQTT_RECONNECT_BASE_DELAY, WM_MQTT_RECONNECT_MAX_DELAY);
+    }
+
+    // Also as mqtt->subscribe(sub), before the session is connected. SUBSCRIBE is sent at each connect
+    bool subscribe(Adafruit_MQTT_Subscribe *sub)
+    {
+      if ( (numSubscriptions >= MAXSUBSCRIPTIONS) || !mqtt->subscribe(sub) )
+        return false;
+
+      subscriptions[numSubscriptions++] = sub;
+
+      return true;
+    }
+
+    void setReconnectDelays(unsigned long baseDelay, unsigned long maxDelay)
+    {
+      backoff.setDelays(baseDelay, maxDelay);
+    }
+
+    bool connected()
+    {
+      return (state == WM_MQTT_CONNECTED);
+    }
+
+    // WM_MQTT_DISCONNECTED, WM_MQTT_CONNECTING, WM_MQTT_SUBSCRIBING or WM_MQTT_CONNECTED
+    uint8_t getState()
+    {
+      return state;
+    }
+
+    // getAttempts(), getDelay() and getTimeToNextAttempt(millis()) of the broker reconnect scheduler
+    const WiFiNINA_Backoff& getReconnectBackoff()
+    {
+      return backoff;
+    }
+
+    void runService(bool wifiConnected, unsigned long timeSlice)
+    {
+      unsigned long startTime = millis();
+
+      if (!wifiConnected)
+      {
+        if (state != WM_MQTT_DISCONNECTED)
+        {
+          WN_LOGERROR(F("m:WLost"));
+
+          mqtt->disconnectServer();
+          state = WM_MQTT_DISCONNECTED;
+        }
+
+        // Connect as soon as WiFi is back
+        backoff.succeeded();
+
+        return;
+      }
+
+      if (state == WM_MQTT_DISCONNECTED)
+      {
+        if (!backoff.due(startTime))
+          return;
+
+        WN_LOGINFO(F("m:ConnM"));
+
+        mqtt->clearReply();
+
+        if (!mqtt->startConnect())
+        {
+          failed();
+
+          return;
+        }
+
+        state     = WM_MQTT_CONNECTING;
+        replyTime = millis();
+
+        // Opening the connection took this run()'s time slice
+        return;
+      }
+
+      if (!mqtt->connected())
+      {
+        failed();
+
+        return;
+      }
+
+      // Packets received, within the time slice
+      while ( mqtt->processNext() && (millis() - startTime < timeSlice) )
+        ;
+
+      uint8_t reply = mqtt->replyType();
+
+      switch (state)
+      {
+        case WM_MQTT_CONNECTING:
+
+          if (reply == MQTT_CTRL_CONNECTACK)
+          {
+            if (mqtt->replyData()[1] != 0)
+            {
+              WN_LOGERROR1(F("m:ConnRefused="), mqtt->replyData()[1]);
+
+              failed();
+
+              return;
+            }
+
+            subscribeIndex = 0;
+            subscribeNext();
+
+            return;
+          }
+
+          break;
+
+        case WM_MQTT_SUBSCRIBING:
+
+          if ( (reply == MQTT_CTRL_SUBACK) && (((mqtt->replyData()[0] << 8) | mqtt->replyData()[1]) == subscribeId) )
+          {
+            subscribeIndex++;
+            subscribeNext();
+
+            return;
+          }
+
+          break;
+
+        case WM_MQTT_CONNECTED:
+
+          if (pingPending)
+          {
+            if (reply == MQTT_CTRL_PINGRESP)
+              pingPending = false;
+          }
+          else if (millis() - pingTime >= mqtt->getKeepAliveInterval() * 500UL)
+          {
+            mqtt->clearReply();
+
+            if (!mqtt->sendPing())
+            {
+              failed();
+
+              return;
+            }
+
+            pingPending = true;
+            pingTime    = millis();
+            replyTime   = pingTime;
+          }
+
+          if (!pingPending)
+            return;
+
+          break;
+      }
+
+      if (millis() - replyTime >= WM_MQTT_REPLY_TIMEOUT)
+      {
+        WN_LOGERROR(F("m:NoReply"));
+
+        failed();
+      }
+    }
+
+  private:
+
+    WiFiNINA_MQTT_Client*     mqtt;
+    WiFiNINA_Backoff          backoff;
+
+    Adafruit_MQTT_Subscribe*  subscriptions[MAXSUBSCRIPTIONS];
+    uint8_t                   numSubscriptions  = 0;
+    uint8_t                   subscribeIndex    = 0;
+    uint16_t                  subscribeId       = 0;
+
+    uint8_t                   state             = WM_MQTT_DISCONNECTED;
+    unsigned long             replyTime         = 0;
+    unsigned long             pingTime          = 0;
+    bool                      pingPending       = false;
+
+    // SUBSCRIBE the next subscription, or connected when all are done
+    void subscribeNext()
+    {
+      if (subscribeIndex >= numSubscriptions)
+      {
+        WN_LOGINFO(F("m:MOK"));
+
+        state       = WM_MQTT_CONNECTED;
+        pingTime    = millis();
+        pingPending = false;
+
+        backoff.succeeded();
+
+        return;
+      }
+
+      mqtt->clearReply();
+
+      if (!mqtt->sendSubscribe(subscriptions[subscribeIndex]->topic, subscriptions[subscribeIndex]->qos, subscribeId))
+      {
+        failed();
+
+        return;
+      }
+
+      state     = WM_MQTT_SUBSCRIBING;
+      replyTime = millis();
+    }
+
+    void failed()
+    {
+      mqtt->disconnectServer();
+
+      state = WM_MQTT_DISCONNECTED;
+
+      backoff.failed(millis());
+
+      WN_LOGERROR3(F("m:NextConnM="), backoff.getDelay(), F(",Try#"), backoff.getAttempts());
+    }
+};
+
+//////////////////////////////////////////////
+
+// New from v1.5.0
+// As Adafruit_MQTT_Publish, for one topic. The packet header, with the topic, is built once in the object. Each
+// publish() then only sets the length, and writes header and payload straight to the client, instead of copying both
+// into buffer. Small payloads go in the same write as the header. Payloads may be larger than MAXBUFFERSIZE.
+// QoS 1 waits for the PUBACK, as Adafruit_MQTT::publish(), or with USE_MQTT_ASYNC_PUBLISH goes through publishAsync()
+class WiFiNINA_MQTT_Topic
+{
+  public:
+
+    WiFiNINA_MQTT_Topic(WiFiNINA_MQTT_Client *mqttClient, const char *topic, uint8_t qos = 0)
+      : mqtt(mqttClient), topic(topic), qos(qos)
+    {
+      size_t len = strlen(topic);
+
+      // Too long : publish() fails
+      topicLen = (len <= WM_MQTT_TOPIC_MAX_LEN) ? len : 0;
+
+      head[HEAD_TOPIC]      = topicLen >> 8;
+      head[HEAD_TOPIC + 1]  = topicLen & 0xFF;
+      memcpy(head + HEAD_TOPIC + 2, topic, topicLen);
+    }
+
+    bool publish(const uint8_t *payload, uint16_t bLen)
+    {
+      if (topicLen == 0)
+        return false;
+
+#if USE_MQTT_ASYNC_PUBLISH
+      if (qos > 0)
+        return mqtt->publishAsync(topic, topicLen, payload, bLen);
+#endif
+
+      uint16_t  idLen     = (qos > 0) ? 2 : 0;
+      uint16_t  packetId  = 0;
+      uint8_t   start     = WiFiNINA_MQTT_putPublishHeader(head, HEAD_TOPIC, qos, 2 + topicLen + idLen + (uint32_t) bLen);
+
+      if (qos > 0)
+      {
+        packetId = mqtt->nextPacketId();
+
+        head[HEAD_TOPIC + 2 + topicLen]     = packetId >> 8;
+        head[HEAD_TOPIC + 2 + topicLen + 1] = packetId & 0xFF;
+      }
+
+      uint16_t headLen = HEAD_TOPIC + 2 + topicLen + idLen - start;
+
+      if (bLen <= WM_MQTT_TOPIC_INLINE_PAYLOAD)
+      {
+        memcpy(head + start + headLen, payload, bLen);
+
+        headLen += bLen;
+        bLen     = 0;
+      }
+
+      if (!mqtt->writePacket(head + start, headLen, payload, bLen))
+        return false;
+
+      return (qos == 0) || mqtt->waitPubAck(packetId, PUBLISH_TIMEOUT_MS);
+    }
+
+    bool publish(const char *payload)
+    {
+      return publish((const uint8_t *) payload, strlen(payload));
+    }
+
+    bool publish(int32_t i)
+    {
+      char payload[12];
+
+      ltoa(i, payload, 10);
+
+      return publish(payload);
+    }
+
+    bool publish(uint32_t i)
+    {
+      char payload[11];
+
+      ultoa(i, payload, 10);
+
+      return publish(payload);
+    }
+
+    bool publish(double f, uint8_t precision = 2)
+    {
+      return publish(String(f, precision).c_str());
+    }
+
+  private:
+
+    // Packet type and up to 4 length bytes, then topic length, topic, packet identifier and small payload
+    static const uint8_t HEAD_TOPIC = 5;
+
+    WiFiNINA_MQTT_Client* mqtt;
+    const char*           topic;
+    uint8_t               qos;
+    uint16_t              topicLen;
+    uint8_t               head[HEAD_TOPIC + 2 + WM_MQTT_TOPIC_MAX_LEN + 2 + WM_MQTT_TOPIC_INLINE_PAYLOAD];
+};
+
+//////////////////////////////////////////////
+
+#ifndef WM_MQTT_SPOOL_RAM_SIZE
+  // Bytes of RAM for messages waiting to be sent. Each takes 4 bytes, its topic and its payload
+  #define WM_MQTT_SPOOL_RAM_SIZE            512
+#endif
+
+#ifndef WM_MQTT_SPOOL_MAX_PAYLOAD
+  // Max payload of a message kept by the spool
+  #define WM_MQTT_SPOOL_MAX_PAYLOAD         64
+#endif
+
+#ifndef WM_MQTT_SPOOL_STORAGE_SIZE
+  // Max bytes kept in the storage. Its messages are all removed when the last one is sent
+  #define WM_MQTT_SPOOL_STORAGE_SIZE        16384L
+#endif
+
+typedef struct
+{
+  uint32_t  queued;           // Messages kept, to be sent later
+  uint32_t  replayed;         // Messages kept, then sent
+  uint32_t  dropped;          // Messages lost, spool full or too large
+  uint32_t  spilled;          // Messages written to the storage
+  uint32_t  replayRate;       // Messages per second sent by the last replay that emptied the spool
+  uint16_t  peakDepth;        // Max messages kept at once
+} WiFiNINA_MQTT_SpoolStats;
+
+// New from v1.5.0
+// Store and forward for a WiFiNINA_MQTT_Client. publish() sends the message if the session is up and nothing waits,
+// else keeps it in RAM. When the RAM is full, its messages are written at once to the storage, if any, such as the
+// WiFiNINA_FileSpool of the nRF52 and RP2040 boards. Without storage, or with the storage full, new messages are
+// dropped. Boards storing config in EEPROM or flash emulating EEPROM keep the messages in RAM only, as each commit
+// there rewrites a whole flash page.
+// The messages are sent again in order, from the storage first, as fast as the session allows : runService() from
+// run() with USE_RUN_SERVICES, or replay() from loop(). QoS 1 goes through publishAsync() with USE_MQTT_ASYNC_PUBLISH.
+// Else it waits for each PUBACK, so it's only replayed by replay(), which may then block loop() up to PUBLISH_TIMEOUT_MS
+// per message, never by runService(). The storage keeps no read position, so a reset during a replay sends its
+// messages again
+class WiFiNINA_MQTT_Spool : public WiFiNINA_Service
+{
+  public:
+
+    WiFiNINA_MQTT_Spool(WiFiNINA_MQTT_Client *mqttClient, WiFiNINA_SpoolStorage *storage = NULL, uint8_t qos = 0)
+      : mqtt(mqttClient), storage(storage), qos(qos)
+    {
+    }
+
+    // With a WiFiNINA_MQTT_Service, send only once it's connected and subscribed
+    void setSession(WiFiNINA_MQTT_Service *mqttService)
+    {
+      session = mqttService;
+    }
+
+    // Take the messages left in the storage, as by a reset. Call once the file system is mounted
+    void begin()
+    {
+      storedCount   = 0;
+      storedStart   = 0;
+      storedEnd     = 0;
+
+      if (!storage)
+        return;
+
+      uint32_t size = storage->size();
+      uint8_t  head[4];
+
+      // Count the whole messages. A partly written last one is dropped
+      while ( (storage->read(storedEnd, head, sizeof(head)) == sizeof(head)) && validHead(head) )
+      {
+        uint32_t next = storedEnd + recordSize(head);
+
+        if (next > size)
+          break;
+
+        storedEnd = next;
+        storedCount++;
+      }
+
+      if (storedCount == 0)
+        storage->clear();
+
+      WN_LOGINFO1(F("s:Stored="), storedCount);
+
+      updatePeak();
+    }
+
+    // Send, or keep to send later. Return false if dropped, as is a message with a topic over WM_MQTT_TOPIC_MAX_LEN
+    // or a payload over WM_MQTT_SPOOL_MAX_PAYLOAD, online or not
+    bool publish(const char *topic, const uint8_t *payload, uint16_t bLen)
+    {
+      if (!fits(topic, bLen))
+      {
+        statistics.dropped++;
+
+        WN_LOGDEBUG1(F("s:Drop,TooLarge="), bLen);
+
+        return false;
+      }
+
+      if ( (depth() == 0) && online() )
+      {
+        loadRecord(topic, payload, bLen);
+
+        if (sendRecord())
+          return true;
+      }
+
+      return keep(topic, payload, bLen);
+    }
+
+    bool publish(const char *topic, const char *payload)
+    {
+      return publish(topic, (const uint8_t *) payload, strlen(payload));
+    }
+
+    // Send the messages kept, in order, until the spool is empty, a send fails, or timeSlice ms
+    void replay(unsigned long timeSlice)
+    {
+      if ( (depth() == 0) || !online() )
+        return;
+
+      unsigned long startTime = millis();
+
+      if (!replaying)
+      {
+        replaying       = true;
+        replayStartTime = startTime;
+        replayCount     = 0;
+      }
+
+      do
+      {
+        if ( !nextRecord() || !sendRecord() )
+          break;
+
+        dropRecord();
+
+        replayCount++;
+        statistics.replayed++;
+      } while ( (depth() > 0) && (millis() - startTime < timeSlice) );
+
+      if (depth() == 0)
+      {
+        unsigned long elapsed = millis() - replayStartTime;
+
+        statistics.replayRate = (replayCount * 1000UL) / (elapsed ? elapsed : 1);
+        replaying             = false;
+
+        WN_LOGINFO3(F("s:Replayed="), replayCount, F(",Rate="), statistics.replayRate);
+      }
+    }
+
+    void runService(bool wifiConnected, unsigned long timeSlice)
+    {
+#if !USE_MQTT_ASYNC_PUBLISH
+      // Would wait for each PUBACK
+      if (qos > 0)
+        return;
+#endif
+
+      if (wifiConnected)
+        replay(timeSlice);
+    }
+
+    // Messages kept, in RAM and in the storage
+    uint16_t depth()
+    {
+      return ramCount + storedCount;
+    }
+
+    const WiFiNINA_MQTT_SpoolStats& spoolStats()
+    {
+      return statistics;
+    }
+
+  private:
+
+    // Record : payload length, topic length, topic, then payload. Read at packet + RECORD_START, so that the topic
+    // length and topic are in place in the PUBLISH packet, and its fixed header goes just before
+    static const uint8_t    RECORD_START  = 3;
+    static const uint8_t    HEAD_TOPIC    = 5;
+    static const uint16_t   MAX_RECORD    = 4 + WM_MQTT_TOPIC_MAX_LEN + WM_MQTT_SPOOL_MAX_PAYLOAD;
+
+    WiFiNINA_MQTT_Client*     mqtt;
+    WiFiNINA_SpoolStorage*    storage;
+    uint8_t                   qos;
+    WiFiNINA_MQTT_Service*    session         = NULL;
+
+    // Messages in RAM, from ramStart to ramEnd
+    uint8_t                   ram[WM_MQTT_SPOOL_RAM_SIZE];
+    uint16_t                  ramStart        = 0;
+    uint16_t                  ramEnd          = 0;
+    uint16_t                  ramCount        = 0;
+
+    // Messages in the storage, from storedStart to storedEnd. Older than those in RAM
+    uint32_t                  storedStart     = 0;
+    uint32_t                  storedEnd       = 0;
+    uint16_t                  storedCount     = 0;
+
+    // Fixed header, packet identifier space, then record
+    uint8_t                   packet[HEAD_TOPIC + 2 + MAX_RECORD];
+
+    WiFiNINA_MQTT_SpoolStats  statistics      = { 0, 0, 0, 0, 0, 0 };
+    bool                      replaying       = false;
+    unsigned long             replayStartTime = 0;
+    uint32_t                  replayCount     = 0;
+
+    bool online()
+    {
+      return session ? session->connected() : mqtt->connected();
+    }
+
+    static bool validHead(const uint8_t* head)
+    {
+      return ( (head[2] == 0) && (head[3] > 0) && (head[3] <= WM_MQTT_TOPIC_MAX_LEN) &&
+               ( ((head[0] << 8) | head[1]) <= WM_MQTT_SPOOL_MAX_PAYLOAD ) );
+    }
+
+    static uint16_t recordSize(const uint8_t* head)
+    {
+      return 4 + head[3] + ((head[0] << 8) | head[1]);
+    }
+
+    void updatePeak()
+    {
+      if (depth() > statistics.peakDepth)
+        statistics.peakDepth = depth();
+    }
+
+    // True if the record of a message fits in packet and ram
+    static bool fits(const char *topic, uint16_t bLen)
+    {
+      size_t topicLen = strlen(topic);
+
+      return ( (topicLen > 0) && (topicLen <= WM_MQTT_TOPIC_MAX_LEN) && (bLen <= WM_MQTT_SPOOL_MAX_PAYLOAD) &&
+               (4 + topicLen + bLen <= WM_MQTT_SPOOL_RAM_SIZE) );
+    }
+
+    // Build the record of a message at packet + RECORD_START. Only for a message that fits()
+    void loadRecord(const char *topic, const uint8_t *payload, uint16_t bLen)
+    {
+      uint8_t   topicLen  = strlen(topic);
+      uint8_t*  p         = packet + RECORD_START;
+
+      *p++ = bLen >> 8;
+      *p++ = bLen & 0xFF;
+      *p++ = 0;
+      *p++ = topicLen;
+
+      memcpy(p, topic, topicLen);
+      memcpy(p + topicLen, payload, bLen);
+    }
+
+    bool keep(const char *topic, const uint8_t *payload, uint16_t bLen)
+    {
+      if (!fits(topic, bLen))
+      {
+        statistics.dropped++;
+
+        return false;
+      }
+
+      uint16_t size = 4 + strlen(topic) + bLen;
+
+      if ( (ramEnd + size > WM_MQTT_SPOOL_RAM_SIZE) && !makeRoom(size) )
+      {
+        statistics.dropped++;
+
+        WN_LOGDEBUG1(F("s:Drop,Depth="), depth());
+
+        return false;
+      }
+
+      loadRecord(topic, payload, bLen);
+      memcpy(ram + ramEnd, packet + RECORD_START, size);
+
+      ramEnd += size;
+      ramCount++;
+
+      statistics.queued++;
+      updatePeak();
+
+      return true;
+    }
+
+    // Make size bytes free at ramEnd : move the messages to the start of ram, else write them all to the storage
+    bool makeRoom(uint16_t size)
+    {
+      if (ramEnd - ramStart + size <= WM_MQTT_SPOOL_RAM_SIZE)
+      {
+        memmove(ram, ram + ramStart, ramEnd - ramStart);
+
+        ramEnd  -= ramStart;
+        ramStart = 0;
+
+        return true;
+      }
+
+      if ( !storage || (storedEnd + (ramEnd - ramStart) > (uint32_t) WM_MQTT_SPOOL_STORAGE_SIZE) )
+        return false;
+
+      if (!storage->append(ram + ramStart, ramEnd - ramStart))
+      {
+        WN_LOGERROR(F("s:SpillFailed"));
+
+        // What was written of the messages is not read. Write again once the stored messages are sent
+        if (storedCount == 0)
+          storage->clear();
+        else
+          storedEnd = WM_MQTT_SPOOL_STORAGE_SIZE;
+
+        return false;
+      }
+
+      WN_LOGDEBUG1(F("s:Spilled="), ramCount);
+
+      storedEnd             += ramEnd - ramStart;
+      storedCount           += ramCount;
+      statistics.spilled    += ramCount;
+
+      ramStart  = 0;
+      ramEnd    = 0;
+      ramCount  = 0;
+
+      return true;
+    }
+
+    // Read the oldest message to packet + RECORD_START
+    bool nextRecord()
+    {
+      uint8_t* record = packet + RECORD_START;
+
+      if (storedCount == 0)
+      {
+        memcpy(record, ram + ramStart, recordSize(ram + ramStart));
+
+        return true;
+      }
+
+      uint16_t count = storage->read(storedStart, record, min( (uint32_t) MAX_RECORD, storedEnd - storedStart));
+
+      if ( (count >= 4) && validHead(record) && (recordSize(record) <= count) )
+        return true;
+
+      WN_LOGERROR1(F("s:BadStored="), storedCount);
+
+      // Unreadable : drop what is left in the storage
+      statistics.dropped += storedCount;
+
+      storage->clear();
+      storedStart = 0;
+      storedEnd   = 0;
+      storedCount = 0;
+
+      return (ramCount > 0) && nextRecord();
+    }
+
+    void dropRecord()
+    {
+      uint16_t size = recordSize(packet + RECORD_START);
+
+      if (storedCount > 0)
+      {
+        storedStart += size;
+
+        // All sent : remove, instead of keeping a read position in flash
+        if (--storedCount == 0)
+        {
+          storage->clear();
+          storedStart = 0;
+          storedEnd   = 0;
+        }
+      }
+      else
+      {
+        ramStart += size;
+
+        if (--ramCount == 0)
+        {
+          ramStart  = 0;
+          ramEnd    = 0;
+        }
+      }
+    }
+
+    // Send the record at packet + RECORD_START, as WiFiNINA_MQTT_Topic::publish()
+    bool sendRecord()
+    {
+      uint8_t*  record    = packet + RECORD_START;
+      uint16_t  bLen      = (record[0] << 8) | record[1];
+      uint8_t   topicLen  = record[3];
+      uint8_t*  payload   = packet + HEAD_TOPIC + 2 + topicLen;
+
+#if USE_MQTT_ASYNC_PUBLISH
+      if (qos > 0)
+        return mqtt->publishAsync((const char *) packet + HEAD_TOPIC + 2, topicLen, payload, bLen);
+#endif
+
+      uint16_t  idLen     = (qos > 0) ? 2 : 0;
+      uint16_t  packetId  = 0;
+      uint8_t   start     = WiFiNINA_MQTT_putPublishHeader(packet, HEAD_TOPIC, qos, 2 + topicLen + idLen + (uint32_t) bLen);
+
+      if (qos > 0)
+      {
+        // Packet identifier between topic and payload
+        memmove(payload + 2, payload, bLen);
+
+        packetId = mqtt->nextPacketId();
+
+        payload[0] = packetId >> 8;
+        payload[1] = packetId & 0xFF;
+      }
+
+      bool sent = mqtt->writePacket(packet + start, HEAD_TOPIC + 2 + topicLen + idLen + bLen - start, NULL, 0) &&
+                  ( (qos == 0) || mqtt->waitPubAck(packetId, PUBLISH_TIMEOUT_MS) );
+
+      // Record as read, in case it's sent again
+      if (qos > 0)
+        memmove(payload, payload + 2, bLen);
+
+      record[0] = bLen >> 8;
+      record[1] = bLen & 0xFF;
+
+      return sent;
+    }
+};
+
+#endif    // WiFiManager_NINA_Lite_MQTT_h
@@ -0,0 +1,403 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_MenuItem.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Typed Dynamic Parameters and Config Portal key lookup. Must be included after MenuItem is declared.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_MenuItem_h
+#define WiFiManager_NINA_Lite_MenuItem_h
+
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+
+// New from v1.5.0
+// A typed item points pdata to a variable of its native type, with maxlen = sizeof(variable). The value is stored
+// in its binary form, converted from / to text only in Config Portal, and validated there before being accepted.
+// Text items (type WM_ITEM_TEXT, the default) still use a char buffer of [maxlen + 1]
+//
+// MenuItem myMenuItems [] =
+// {
+//   { "svr", "AIO_SERVER",      AIO_SERVER,                 AIO_SERVER_LEN },
+//   { "prt", "AIO_SERVERPORT",  (char *) &AIO_SERVERPORT,   sizeof(AIO_SERVERPORT),   WM_ITEM_UINT16 },
+//   { "mod", "MODE",            (char *) &MODE,             sizeof(MODE),             WM_ITEM_ENUM,   "off|low|high" },
+// };
+
+#define WM_ITEM_TEXT          0       // char[maxlen + 1]
+#define WM_ITEM_UINT16        1       // uint16_t
+#define WM_ITEM_INT32         2       // int32_t
+#define WM_ITEM_FLOAT         3       // float, -WM_ITEM_FLOAT_MAX < value < WM_ITEM_FLOAT_MAX
+#define WM_ITEM_BOOL          4       // bool. Accepts 1/0, true/false, on/off
+#define WM_ITEM_ENUM          5       // uint8_t index into options, such as "off|low|high". Accepts the name or index
+#define WM_ITEM_IP            6       // uint32_t, IPAddress octets in memory order. Convert with IPAddress(value)
+
+// Keeps String(float, 6) within the 33 bytes dtostrf() buffer of some cores : 10 digits, '.', 6 decimals and sign
+#define WM_ITEM_FLOAT_MAX     1e9
+
+//////////////////////////////////////////////
+
+// Native width of a typed item, 0 for text
+inline uint8_t WiFiNINA_menuItemWidth(uint8_t type)
+{
+  switch (type)
+  {
+    case WM_ITEM_UINT16:
+      return sizeof(uint16_t);
+    case WM_ITEM_INT32:
+      return sizeof(int32_t);
+    case WM_ITEM_FLOAT:
+      return sizeof(float);
+    case WM_ITEM_BOOL:
+      return sizeof(bool);
+    case WM_ITEM_ENUM:
+      return sizeof(uint8_t);
+    case WM_ITEM_IP:
+      return sizeof(uint32_t);
+    default:
+      return 0;
+  }
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_clearMenuItem(const MenuItem& item)
+{
+  // Actual size of pdata is [maxlen + 1] for text, [maxlen] for typed items
+  memset(item.pdata, 0, (item.type == WM_ITEM_TEXT) ? item.maxlen + 1 : item.maxlen);
+}
+
+//////////////////////////////////////////////
+
+// Return the index of name in options "a|b|c", or -1
+inline int WiFiNINA_findEnumOption(const char* options, const char* name)
+{
+  uint16_t nameLength = strlen(name);
+  int      index      = 0;
+
+  while (options && *options)
+  {
+    const char* end = strchr(options, '|');
+    uint16_t    len = end ? (end - options) : strlen(options);
+
+    if ( (len == nameLength) && (strncmp(options, name, len) == 0) )
+      return index;
+
+    if (!end)
+      break;
+
+    options = end + 1;
+    index++;
+  }
+
+  return -1;
+}
+
+//////////////////////////////////////////////
+
+inline String WiFiNINA_enumOptionName(const char* options, uint8_t index)
+{
+  for (uint8_t i = 0; options && *options; i++)
+  {
+    const char* end = strchr(options, '|');
+
+    if (i == index)
+      return end ? String(options).substring(0, end - options) : String(options);
+
+    if (!end)
+      break;
+
+    options = end + 1;
+  }
+
+  return String(index);
+}
+
+//////////////////////////////////////////////
+
+inline String WiFiNINA_menuItemToString(const MenuItem& item)
+{
+  // Wrong width => don't touch pdata
+  if ( (item.type != WM_ITEM_TEXT) && (item.maxlen != WiFiNINA_menuItemWidth(item.type)) )
+    return String();
+
+  switch (item.type)
+  {
+    case WM_ITEM_UINT16:
+      return String(* (uint16_t *) item.pdata);
+
+    case WM_ITEM_INT32:
+      return String((long) * (int32_t *) item.pdata);
+
+    case WM_ITEM_FLOAT:
+    {
+      // Not from the portal, such as sketch defaults. Don't format what may not fit
+      if ( !isfinite(* (float *) item.pdata) || (fabs(* (float *) item.pdata) >= WM_ITEM_FLOAT_MAX) )
+        return String();
+
+      // Remove trailing zeros
+      String value = String(* (float *) item.pdata, 6);
+
+      while (value.endsWith("0"))
+        value.remove(value.length() - 1);
+
+      if (value.endsWith("."))
+        value.remove(value.length() - 1);
+
+      return value;
+    }
+
+    case WM_ITEM_BOOL:
+      return (* (bool *) item.pdata) ? String("1") : String("0");
+
+    case WM_ITEM_ENUM:
+      return WiFiNINA_enumOptionName(item.options, * (uint8_t *) item.pdata);
+
+    case WM_ITEM_IP:
+    {
+      const uint8_t* octet = (const uint8_t *) item.pdata;
+
+      return String(octet[0]) + "." + octet[1] + "." + octet[2] + "." + octet[3];
+    }
+
+    default:
+      return String(item.pdata);
+  }
+}
+
+//////////////////////////////////////////////
+
+inline bool WiFiNINA_parseIP(const char* text, uint8_t* octet)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    char* end;
+
+    if ( (*text < '0') || (*text > '9') )
+      return false;
+
+    unsigned long value = strtoul(text, &end, 10);
+
+    if ( (value > 255) || (*end != ( (i < 3) ? '.' : 0 )) )
+      return false;
+
+    octet[i] = value;
+    text     = end + 1;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////
+
+// Convert and validate the text from Config Portal. Return false and keep the current value if invalid
+inline bool WiFiNINA_setMenuItem(const MenuItem& item, const char* text)
+{
+  char* end;
+
+  if (item.type == WM_ITEM_TEXT)
+  {
+    WiFiNINA_clearMenuItem(item);
+    strncpy(item.pdata, text, item.maxlen);
+
+    return true;
+  }
+
+  if ( (item.maxlen != WiFiNINA_menuItemWidth(item.type)) || (*text == 0) )
+    return false;
+
+  switch (item.type)
+  {
+    case WM_ITEM_UINT16:
+    {
+      if ( (*text < '0') || (*text > '9') )
+        return false;
+
+      errno = 0;
+
+      unsigned long value = strtoul(text, &end, 10);
+
+      if ( (errno == ERANGE) || (*end != 0) || (value > 0xFFFF) )
+        return false;
+
+      * (uint16_t *) item.pdata = value;
+
+      return true;
+    }
+
+    case WM_ITEM_INT32:
+    {
+      if ( ( (*text < '0') || (*text > '9') ) && (*text != '-') )
+        return false;
+
+      // Out of range is ERANGE where long is 32-bit, and beyond INT32_MIN / INT32_MAX where it's 64-bit
+      errno = 0;
+
+      long value = strtol(text, &end, 10);
+
+      if ( (errno == ERANGE) || (end == text) || (*end != 0) || (value < INT32_MIN) || (value > INT32_MAX) )
+        return false;
+
+      * (int32_t *) item.pdata = value;
+
+      return true;
+    }
+
+    case WM_ITEM_FLOAT:
+    {
+      double value = strtod(text, &end);
+
+      // No nan, inf, nor values too large to be formatted back, once rounded to float
+      if ( (end == text) || (*end != 0) || !isfinite(value) || (fabs((float) value) >= WM_ITEM_FLOAT_MAX) )
+        return false;
+
+      * (float *) item.pdata = value;
+
+      return true;
+    }
+
+    case WM_ITEM_BOOL:
+    {
+      if ( !strcmp(text, "1") || !strcasecmp(text, "true") || !strcasecmp(text, "on") )
+        * (bool *) item.pdata = true;
+      else if ( !strcmp(text, "0") || !strcasecmp(text, "false") || !strcasecmp(text, "off") )
+        * (bool *) item.pdata = false;
+      else
+        return false;
+
+      return true;
+    }
+
+    case WM_ITEM_ENUM:
+    {
+      int index = WiFiNINA_findEnumOption(item.options, text);
+
+      if (index < 0)
+      {
+        // Also accept the index
+        unsigned long value = strtoul(text, &end, 10);
+
+        if ( (*end != 0) || (value > 0xFF) || (WiFiNINA_enumOptionName(item.options, value) == String(value)) )
+          return false;
+
+        index = value;
+      }
+
+      * (uint8_t *) item.pdata = index;
+
+      return true;
+    }
+
+    case WM_ITEM_IP:
+    {
+      uint8_t octet[4];
+
+      if (!WiFiNINA_parseIP(text, octet))
+        return false;
+
+      memcpy(item.pdata, octet, sizeof(octet));
+
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////
+
+// New from v1.5.0
+// Config Portal key dispatch without String temporaries. Built-in keys are matched directly, dynamic item ids
+// through an index sorted once by id, then binary-searched for each request.
+
+#define WM_KEY_NONE           0
+#define WM_KEY_ID             1
+#define WM_KEY_PW             2
+#define WM_KEY_ID1            3
+#define WM_KEY_PW1            4
+#define WM_KEY_NM             5
+#define WM_KEY_IP             6
+#define WM_KEY_GW             7
+#define WM_KEY_SN             8
+#define WM_KEY_DNS            9
+
+inline uint8_t WiFiNINA_builtinKey(const char* key)
+{
+  if (!strcmp(key, "id"))
+    return WM_KEY_ID;
+  else if (!strcmp(key, "pw"))
+    return WM_KEY_PW;
+  else if (!strcmp(key, "id1"))
+    return WM_KEY_ID1;
+  else if (!strcmp(key, "pw1"))
+    return WM_KEY_PW1;
+  else if (!strcmp(key, "nm"))
+    return WM_KEY_NM;
+#if (defined(USE_STATIC_IP_CONFIG) && USE_STATIC_IP_CONFIG)
+  else if (!strcmp(key, "ip"))
+    return WM_KEY_IP;
+  else if (!strcmp(key, "gw"))
+    return WM_KEY_GW;
+  else if (!strcmp(key, "sn"))
+    return WM_KEY_SN;
+  else if (!strcmp(key, "dns"))
+    return WM_KEY_DNS;
+#endif
+
+  return WM_KEY_NONE;
+}
+
+//////////////////////////////////////////////
+
+// Fill index[numItems] with the item positions, sorted by id. Insertion sort, done once
+inline void WiFiNINA_buildMenuItemIndex(const MenuItem* items, uint16_t* index, uint16_t numItems)
+{
+  for (uint16_t i = 0; i < numItems; i++)
+  {
+    uint16_t j = i;
+
+    while ( (j > 0) && (strcmp(items[index[j - 1]].id, items[i].id) > 0) )
+    {
+      index[j] = index[j - 1];
+      j--;
+    }
+
+    index[j] = i;
+  }
+}
+
+//////////////////////////////////////////////
+
+// Return the position of the item with this id, or -1
+inline int WiFiNINA_findMenuItem(const MenuItem* items, const uint16_t* index, uint16_t numItems, const char* key)
+{
+  uint16_t low  = 0;
+  uint16_t high = numItems;
+
+  while (low < high)
+  {
+    uint16_t middle = (low + high) / 2;
+    int      result = strcmp(key, items[index[middle]].id);
+
+    if (result == 0)
+      return index[middle];
+
+    if (result < 0)
+      high = middle;
+    else
+      low = middle + 1;
+  }
+
+  return -1;
+}
+
+#endif    // WiFiManager_NINA_Lite_MenuItem_h
@@ -0,0 +1,287 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_NoInit.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Transient flags (Double Reset and non-persistent forced Config Portal) kept in RAM not initialized at startup,
+  or in backup / retained registers on SAM DUE, nRF52 and STM32, instead of EEPROM / flash.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_NoInit_h
+#define WiFiManager_NINA_Lite_NoInit_h
+
+// New from v1.5.0
+// Keep the DRD flag and the non-persistent forced CP flag in no-init RAM, so that EEPROM / flash is no longer
+// written on every boot. The flags survive a reset (reset button, software reset), but not a power cycle.
+// Persistent forced CP is still stored in EEPROM / flash.
+// SAM DUE : General Purpose Backup Registers. nRF52 : GPREGRET2. STM32 : one RTC backup register.
+// AVR and RP2040 with the Arduino-pico core : a RAM section their linker scripts don't zero at startup.
+// Other cores keep the flags in EEPROM / flash as before, unless WM_NOINIT_SECTION names such a section of their linker script.
+#ifndef USE_NOINIT_RAM_FLAGS
+  #define USE_NOINIT_RAM_FLAGS      false
+#endif
+
+#if USE_NOINIT_RAM_FLAGS
+
+#define WM_NOINIT_MAGIC             0x574D4E49      // "WMNI"
+#define WM_NOINIT_DRD_FLAG          0xD0D01234
+#define WM_NOINIT_FORCED_CP_FLAG    0xDEADBEEF      // FORCED_CONFIG_PORTAL_FLAG_DATA, the only non-persistent value
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t drdFlag;
+  uint32_t forcedCPFlag;
+  uint32_t check;             // To reject random RAM content after power-on
+} WiFiNINA_NoInitFlags;
+
+#if ( defined(ARDUINO_SAM_DUE) || defined(__SAM3X8E__) )
+  // General Purpose Backup Registers, 8 x 32-bit, kept over any reset as long as VDDBU is powered
+  #define WM_NOINIT_FLAGS           ( (volatile WiFiNINA_NoInitFlags *) &GPBR->SYS_GPBR[0] )
+
+#elif ( defined(NRF52840_FEATHER) || defined(NRF52832_FEATHER) || defined(NRF52_SERIES) || defined(ARDUINO_NRF52_ADAFRUIT) )
+  #include <nrf_sdm.h>
+  #include <nrf_soc.h>
+
+  // GPREGRET2, 8-bit, kept over any reset but power-on and brownout. GPREGRET is left to the bootloader (DFU / UF2)
+  #define WM_NOINIT_REGISTER        true
+  #define WM_NOINIT_REGISTER_ID     1
+
+  inline uint32_t WiFiNINA_readNoInitRegister()
+  {
+    uint8_t  sdEnabled = 0;
+    uint32_t value;
+
+    // POWER registers are only reachable through the SoftDevice while it's enabled
+    sd_softdevice_is_enabled(&sdEnabled);
+
+    if (sdEnabled)
+      sd_power_gpregret_get(WM_NOINIT_REGISTER_ID, &value);
+    else
+      value = NRF_POWER->GPREGRET2;
+
+    return value;
+  }
+
+  inline void WiFiNINA_writeNoInitRegister(uint32_t value)
+  {
+    uint8_t sdEnabled = 0;
+
+    sd_softdevice_is_enabled(&sdEnabled);
+
+    if (sdEnabled)
+    {
+      sd_power_gpregret_clr(WM_NOINIT_REGISTER_ID, 0xFF);
+      sd_power_gpregret_set(WM_NOINIT_REGISTER_ID, value);
+    }
+    else
+      NRF_POWER->GPREGRET2 = value;
+  }
+
+#elif defined(ARDUINO_ARCH_STM32)
+  #include <backup.h>
+
+  // 16-bit on STM32F1. Kept over any reset, and over power cycles only with VBAT.
+  // STM32RTC uses LL_RTC_BKP_DR1. DR4 is the last one on STM32L0 / G0
+  #ifndef WM_NOINIT_BKP_INDEX
+    #define WM_NOINIT_BKP_INDEX     LL_RTC_BKP_DR4
+  #endif
+
+  #define WM_NOINIT_REGISTER        true
+
+  inline uint32_t WiFiNINA_readNoInitRegister()
+  {
+    enableBackupDomain();
+
+    return getBackupRegister(WM_NOINIT_BKP_INDEX);
+  }
+
+  inline void WiFiNINA_writeNoInitRegister(uint32_t value)
+  {
+    enableBackupDomain();
+    setBackupRegister(WM_NOINIT_BKP_INDEX, value);
+  }
+
+#else
+  // Section must not be zeroed by the startup code
+  #if !defined(WM_NOINIT_SECTION)
+    #if ( defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED) )
+      // memmap_default.ld of the Pico SDK
+      #define WM_NOINIT_SECTION     ".uninitialized_data"
+    #elif defined(__AVR__)
+      // Linker scripts of avr-libc
+      #define WM_NOINIT_SECTION     ".noinit"
+    #endif
+  #endif
+
+  #if defined(WM_NOINIT_SECTION)
+    volatile WiFiNINA_NoInitFlags WiFiNINA_noInitFlags __attribute__ ((section (WM_NOINIT_SECTION)));
+
+    #define WM_NOINIT_FLAGS         ( &WiFiNINA_noInitFlags )
+  #else
+    // Such as SAMD, Teensy and RP2040 mbed core, whose linker scripts zero all RAM sections
+    #warning USE_NOINIT_RAM_FLAGS : no section not zeroed at startup known for this core. Flags stay in EEPROM / flash
+    
+    #undef  USE_NOINIT_RAM_FLAGS
+    #define USE_NOINIT_RAM_FLAGS    false
+  #endif
+#endif
+
+#endif    // USE_NOINIT_RAM_FLAGS
+
+#if USE_NOINIT_RAM_FLAGS
+
+#if WM_NOINIT_REGISTER
+
+// [7:4] WM_NOINIT_REGISTER_MAGIC, [1] forced CP, [0] DRD. Register is 0 after power-on
+#define WM_NOINIT_REGISTER_MAGIC    0xA0
+#define WM_NOINIT_REGISTER_DRD      0x01
+#define WM_NOINIT_REGISTER_CP       0x02
+
+inline bool WiFiNINA_readNoInitFlags(uint32_t& drdFlag, uint32_t& forcedCPFlag)
+{
+  uint32_t value = WiFiNINA_readNoInitRegister();
+
+  if ( (value & 0xF0) != WM_NOINIT_REGISTER_MAGIC)
+    return false;
+
+  drdFlag       = (value & WM_NOINIT_REGISTER_DRD) ? WM_NOINIT_DRD_FLAG : 0;
+  forcedCPFlag  = (value & WM_NOINIT_REGISTER_CP)  ? WM_NOINIT_FORCED_CP_FLAG : 0;
+
+  return true;
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_writeNoInitFlags(uint32_t drdFlag, uint32_t forcedCPFlag)
+{
+  WiFiNINA_writeNoInitRegister( WM_NOINIT_REGISTER_MAGIC | (drdFlag ? WM_NOINIT_REGISTER_DRD : 0) |
+                                (forcedCPFlag ? WM_NOINIT_REGISTER_CP : 0) );
+}
+
+#else
+
+inline uint32_t WiFiNINA_noInitCheck(uint32_t drdFlag, uint32_t forcedCPFlag)
+{
+  return ~(WM_NOINIT_MAGIC ^ drdFlag ^ forcedCPFlag);
+}
+
+//////////////////////////////////////////////
+
+inline bool WiFiNINA_readNoInitFlags(uint32_t& drdFlag, uint32_t& forcedCPFlag)
+{
+  if ( (WM_NOINIT_FLAGS->magic != WM_NOINIT_MAGIC) ||
+       (WM_NOINIT_FLAGS->check != WiFiNINA_noInitCheck(WM_NOINIT_FLAGS->drdFlag, WM_NOINIT_FLAGS->forcedCPFlag)) )
+    return false;
+
+  drdFlag       = WM_NOINIT_FLAGS->drdFlag;
+  forcedCPFlag  = WM_NOINIT_FLAGS->forcedCPFlag;
+
+  return true;
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_writeNoInitFlags(uint32_t drdFlag, uint32_t forcedCPFlag)
+{
+  WM_NOINIT_FLAGS->magic        = WM_NOINIT_MAGIC;
+  WM_NOINIT_FLAGS->drdFlag      = drdFlag;
+  WM_NOINIT_FLAGS->forcedCPFlag = forcedCPFlag;
+  WM_NOINIT_FLAGS->check        = WiFiNINA_noInitCheck(drdFlag, forcedCPFlag);
+}
+
+#endif    // WM_NOINIT_REGISTER
+
+//////////////////////////////////////////////
+
+inline uint32_t WiFiNINA_getNoInitDRD()
+{
+  uint32_t drdFlag, forcedCPFlag;
+
+  return WiFiNINA_readNoInitFlags(drdFlag, forcedCPFlag) ? drdFlag : 0;
+}
+
+//////////////////////////////////////////////
+
+inline uint32_t WiFiNINA_getNoInitForcedCP()
+{
+  uint32_t drdFlag, forcedCPFlag;
+
+  return WiFiNINA_readNoInitFlags(drdFlag, forcedCPFlag) ? forcedCPFlag : 0;
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_setNoInitDRD(uint32_t drdFlag)
+{
+  WiFiNINA_writeNoInitFlags(drdFlag, WiFiNINA_getNoInitForcedCP());
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_setNoInitForcedCP(uint32_t forcedCPFlag)
+{
+  WiFiNINA_writeNoInitFlags(WiFiNINA_getNoInitDRD(), forcedCPFlag);
+}
+
+//////////////////////////////////////////////
+
+// Same interface and behaviour as DoubleResetDetector_Generic, without touching EEPROM / flash
+class WiFiNINA_NoInitDRD
+{
+  public:
+
+    WiFiNINA_NoInitDRD(int timeout)
+    {
+      this->timeout = timeout * 1000;
+    }
+
+    bool detectDoubleReset()
+    {
+      doubleResetDetected = (WiFiNINA_getNoInitDRD() == WM_NOINIT_DRD_FLAG);
+
+      if (doubleResetDetected)
+      {
+        WiFiNINA_setNoInitDRD(0);
+      }
+      else
+      {
+        WiFiNINA_setNoInitDRD(WM_NOINIT_DRD_FLAG);
+        waitingForDoubleReset = true;
+      }
+
+      return doubleResetDetected;
+    }
+
+    void loop()
+    {
+      if (waitingForDoubleReset && (millis() > timeout))
+      {
+        stop();
+      }
+    }
+
+    void stop()
+    {
+      WiFiNINA_setNoInitDRD(0);
+      waitingForDoubleReset = false;
+    }
+
+    bool doubleResetDetected    = false;
+
+  private:
+
+    unsigned long timeout;
+    bool          waitingForDoubleReset = false;
+};
+
+#endif    // USE_NOINIT_RAM_FLAGS
+
+#endif    // WiFiManager_NINA_Lite_NoInit_h
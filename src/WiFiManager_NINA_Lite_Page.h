@@ -0,0 +1,215 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Page.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Config Portal page written straight to the client, with its length known beforehand.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Page_h
+#define WiFiManager_NINA_Lite_Page_h
+
+// New from v1.5.0
+// The Config Portal page is written twice from its fragments and values : once only counting its bytes, then to the
+// client, after a header with that Content-Length. No String holds the page, instead of one growing with each += and
+// replace(). Values are written as they are, never searched again for [[key]]
+#ifndef USE_PAGE_STREAMING
+  #define USE_PAGE_STREAMING                false
+#endif
+
+#ifndef WM_PAGE_BUFFER_SIZE
+  // Bytes of the page written to the client at once
+  #define WM_PAGE_BUFFER_SIZE               512
+#endif
+
+#ifndef WM_PAGE_SEND_TIMEOUT
+  // ms. Give up the page when the client takes no byte for this long
+  #define WM_PAGE_SEND_TIMEOUT              2000L
+#endif
+
+#if USE_PAGE_STREAMING
+
+class WiFiNINA_PageWriter
+{
+  public:
+
+    // Only counts the bytes if client is NULL
+    WiFiNINA_PageWriter(Client *client = NULL) : client(client)
+    {
+    }
+
+    // name is written for each token, as the board name in the page
+    void setName(const char* token, const char* name)
+    {
+      nameToken = token;
+      nameValue = name;
+    }
+
+    void write(const char* data, size_t length)
+    {
+      total += length;
+
+      if (!client)
+        return;
+
+      if (used + length > sizeof(buffer))
+      {
+        flush();
+
+        if (length >= sizeof(buffer))
+        {
+          send(data, length);
+
+          return;
+        }
+      }
+
+      memcpy(buffer + used, data, length);
+      used += length;
+    }
+
+    void print(const char* text)
+    {
+      write(text, strlen(text));
+    }
+
+    void print(const String& text)
+    {
+      write(text.c_str(), text.length());
+    }
+
+    // Write text, with each [[key]] or {k} written by value(page, token, tokenLength), or kept if value() returns false,
+    // and each name token replaced by the name
+    template<class ValueFunction>
+    void expand(const char* text, ValueFunction value)
+    {
+      size_t tokenLen = nameToken ? strlen(nameToken) : 0;
+      const char* start = text;
+
+      while (*text)
+      {
+        size_t len = 0;
+
+        if ( (text[0] == '[') && (text[1] == '[') )
+        {
+          // Keys are short, as [[id]] or [[{v}]]
+          for (size_t i = 2; text[i] && (text[i] != '[') && (i < 2 + MAX_KEY_LEN); i++)
+          {
+            if ( (text[i] == ']') && (text[i + 1] == ']') )
+            {
+              len = i + 2;
+              break;
+            }
+          }
+        }
+        else if ( (text[0] == '{') && text[1] && (text[2] == '}') )
+        {
+          len = 3;
+        }
+        else if ( tokenLen && (text[0] == nameToken[0]) && (strncmp(text, nameToken, tokenLen) == 0) )
+        {
+          write(start, text - start);
+          print(nameValue);
+
+          text += tokenLen;
+          start = text;
+
+          continue;
+        }
+
+        if (len)
+        {
+          write(start, text - start);
+
+          if (!value(*this, text, len))
+            write(text, len);
+
+          text += len;
+          start = text;
+        }
+        else
+        {
+          text++;
+        }
+      }
+
+      write(start, text - start);
+    }
+
+    // Write what is left in the buffer. Return false if the client failed
+    bool flush()
+    {
+      if (used > 0)
+      {
+        send(buffer, used);
+        used = 0;
+      }
+
+      return !failed;
+    }
+
+    // Bytes of the page so far
+    size_t length()
+    {
+      return total;
+    }
+
+  private:
+
+    static const uint8_t MAX_KEY_LEN = 16;
+
+    Client*     client;
+    const char* nameToken = NULL;
+    const char* nameValue = "";
+    char        buffer[WM_PAGE_BUFFER_SIZE];
+    size_t      used      = 0;
+    size_t      total     = 0;
+    bool        failed    = false;
+
+    void send(const char* data, size_t length)
+    {
+      unsigned long startTime = millis();
+
+      while (!failed && (length > 0))
+      {
+        size_t written = client->write((const uint8_t *) data, length);
+
+        if (written == 0)
+        {
+          if ( !client->connected() || (millis() - startTime > WM_PAGE_SEND_TIMEOUT) )
+          {
+            WN_LOGDEBUG(F("h:PageTimeout"));
+
+            failed = true;
+          }
+
+          continue;
+        }
+
+        data      += written;
+        length    -= written;
+        startTime  = millis();
+      }
+    }
+};
+
+//////////////////////////////////////////////
+
+// Is token "[[key]]"
+inline bool WiFiNINA_isPageKey(const char* token, size_t tokenLen, const char* key)
+{
+  size_t keyLen = strlen(key);
+
+  return ( (tokenLen == keyLen + 4) && (strncmp(token + 2, key, keyLen) == 0) );
+}
+
+#endif    // USE_PAGE_STREAMING
+
+#endif    // WiFiManager_NINA_Lite_Page_h
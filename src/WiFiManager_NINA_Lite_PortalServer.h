@@ -0,0 +1,830 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_PortalServer.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Config Portal server serving several NINA sockets round-robin, with HTTP/1.1 keep-alive.
+  Implements the subset of the WiFiWebServer API used by the library.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_PortalServer_h
+#define WiFiManager_NINA_Lite_PortalServer_h
+
+// New from v1.5.0
+// WiFiWebServer serves one connection at a time and closes it after each request. With USE_PORTAL_SERVER, up to
+// WM_PORTAL_MAX_CLIENTS connections are kept open and served in turn, one complete request per handleClient() call.
+// Reads never block, and every connection has time budgets for receiving a request, idling and sending a response.
+#ifndef USE_PORTAL_SERVER
+  #define USE_PORTAL_SERVER                 false
+#endif
+
+#if USE_PORTAL_SERVER
+
+#ifndef WM_PORTAL_MAX_CLIENTS
+  // NINA firmware has 10 sockets in total, shared with the sketch
+  #define WM_PORTAL_MAX_CLIENTS             4
+#endif
+
+#ifndef WM_PORTAL_BUFFER_SIZE
+  // Per connection. Holds the request line, headers and body of one request
+  #if (defined(USE_JSON_CONFIG_API) && USE_JSON_CONFIG_API)
+    // Room for a POST /config.json with all WiFi Credentials
+    #define WM_PORTAL_BUFFER_SIZE           1024
+  #else
+    #define WM_PORTAL_BUFFER_SIZE           512
+  #endif
+#endif
+
+#ifndef WM_PORTAL_MAX_HANDLERS
+  #define WM_PORTAL_MAX_HANDLERS            8
+#endif
+
+#ifndef WM_PORTAL_MAX_ARGS
+  #define WM_PORTAL_MAX_ARGS                8
+#endif
+
+#ifndef WM_PORTAL_REQUEST_TIMEOUT
+  // From the first byte to the complete request
+  #define WM_PORTAL_REQUEST_TIMEOUT         3000L
+#endif
+
+#ifndef WM_PORTAL_KEEPALIVE_TIMEOUT
+  // Idle keep-alive connection is closed after this
+  #define WM_PORTAL_KEEPALIVE_TIMEOUT       5000L
+#endif
+
+#ifndef WM_PORTAL_SEND_TIMEOUT
+  #define WM_PORTAL_SEND_TIMEOUT            2000L
+#endif
+
+#ifndef WM_PORTAL_WRITE_UNIT
+  #define WM_PORTAL_WRITE_UNIT              1460
+#endif
+
+#ifndef CONTENT_LENGTH_NOT_SET
+  // As WiFiWebServer
+  #define CONTENT_LENGTH_NOT_SET            ((size_t) -2)
+#endif
+
+class WiFiNINA_PortalServer
+{
+  public:
+
+    typedef WiFiWebServer::THandlerFunction THandlerFunction;
+
+    WiFiNINA_PortalServer(uint16_t port = 80) : server(port)
+    {
+    }
+
+    ~WiFiNINA_PortalServer()
+    {
+      for (uint8_t i = 0; i < WM_PORTAL_MAX_CLIENTS; i++)
+      {
+        if (slots[i].active)
+          closeSlot(slots[i]);
+      }
+    }
+
+    void begin()
+    {
+      server.begin();
+    }
+
+    void on(const String& uri, THandlerFunction handler)
+    {
+      on(uri, HTTP_ANY, handler);
+    }
+
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler)
+    {
+      if (numHandlers < WM_PORTAL_MAX_HANDLERS)
+      {
+        handlers[numHandlers].uri     = uri;
+        handlers[numHandlers].method  = method;
+        handlers[numHandlers].handler = handler;
+        numHandlers++;
+      }
+      else
+      {
+        WN_LOGERROR1(F("PS:Too many handlers, max="), WM_PORTAL_MAX_HANDLERS);
+      }
+    }
+
+    void onNotFound(THandlerFunction handler)
+    {
+      notFoundHandler = handler;
+    }
+
+    //////////////////////////////////////////////
+
+    void handleClient()
+    {
+      unsigned long now = millis();
+
+      acceptClient(now);
+
+      bool served = false;
+
+      for (uint8_t n = 0; n < WM_PORTAL_MAX_CLIENTS; n++)
+      {
+        uint8_t index = (nextSlot + n) % WM_PORTAL_MAX_CLIENTS;
+        Slot&   slot  = slots[index];
+
+        if (!slot.active)
+          continue;
+
+        readSlot(slot, now);
+
+        int requestLength = completeRequestLength(slot);
+
+        if (requestLength < 0)
+        {
+          // Too large or malformed
+          current = &slot;
+          keepAlive = false;
+          send(requestLength == -2 ? 413 : 400, "text/plain", "");
+          closeSlot(slot);
+        }
+        else if ( (requestLength > 0) && !served )
+        {
+          // One request per call, then the next connection gets the first turn
+          served   = true;
+          nextSlot = (index + 1) % WM_PORTAL_MAX_CLIENTS;
+
+          serveRequest(slot, requestLength);
+        }
+        else if ( (requestLength == 0) && (slot.length > 0) && (now - slot.requestStart > WM_PORTAL_REQUEST_TIMEOUT) )
+        {
+          WN_LOGDEBUG1(F("PS:Request timeout, slot="), index);
+
+          current = &slot;
+          keepAlive = false;
+          send(408, "text/plain", "");
+          closeSlot(slot);
+        }
+        else if ( (slot.length == 0) && ( !slot.client.connected() || (now - slot.lastActivity > WM_PORTAL_KEEPALIVE_TIMEOUT) ) )
+        {
+          closeSlot(slot);
+        }
+      }
+
+      current = NULL;
+    }
+
+    //////////////////////////////////////////////
+
+    String arg(const String& name)
+    {
+      for (uint8_t i = 0; i < numArgs; i++)
+      {
+        if (name == argNames[i])
+          return String(argValues[i]);
+      }
+
+      return String();
+    }
+
+    String arg(int i)
+    {
+      return (i < numArgs) ? String(argValues[i]) : String();
+    }
+
+    String argName(int i)
+    {
+      return (i < numArgs) ? String(argNames[i]) : String();
+    }
+
+    int args()
+    {
+      return numArgs;
+    }
+
+    bool hasArg(const String& name)
+    {
+      for (uint8_t i = 0; i < numArgs; i++)
+      {
+        if (name == argNames[i])
+          return true;
+      }
+
+      return false;
+    }
+
+    String uri()
+    {
+      return String(currentUri);
+    }
+
+    HTTPMethod method()
+    {
+      return currentMethod;
+    }
+
+    String hostHeader()
+    {
+      return String(currentHost);
+    }
+
+    WiFiClient& client()
+    {
+      return current ? current->client : noClient;
+    }
+
+    //////////////////////////////////////////////
+
+    void sendHeader(const String& name, const String& value, bool first = false)
+    {
+      String header = name + ": " + value + "\r\n";
+
+      if (first)
+        responseHeaders = header + responseHeaders;
+      else
+        responseHeaders += header;
+    }
+
+    // As WiFiWebServer : the next send() tells this Content-Length, and the content is then written to client()
+    void setContentLength(size_t length)
+    {
+      contentLength = length;
+    }
+
+    void send(int code, const char* contentType, const String& content)
+    {
+      if (!current)
+        return;
+
+      size_t length = (contentLength != CONTENT_LENGTH_NOT_SET) ? contentLength : content.length();
+
+      contentLength = CONTENT_LENGTH_NOT_SET;
+
+      String response = responseHeader(code, contentType, length, content.length());
+
+      // Small responses go out in one write, large ones are written straight from content
+      if (content.length() <= WM_PORTAL_WRITE_UNIT)
+      {
+        response += content;
+        writeData(response.c_str(), response.length());
+      }
+      else if (writeData(response.c_str(), response.length()))
+      {
+        writeData(content.c_str(), content.length());
+      }
+    }
+
+    // Content in flash (PROGMEM on AVR), copied out through a small buffer
+    void send_P(int code, const char* contentType, PGM_P content, size_t length)
+    {
+      if (!current)
+        return;
+
+      String response = responseHeader(code, contentType, length, 0);
+
+      if (!writeData(response.c_str(), response.length()))
+        return;
+
+      char buffer[64];
+
+      while (length > 0)
+      {
+        size_t chunk = (length < sizeof(buffer)) ? length : sizeof(buffer);
+
+        memcpy_P(buffer, content, chunk);
+
+        if (!writeData(buffer, chunk))
+          return;
+
+        content += chunk;
+        length  -= chunk;
+      }
+    }
+
+    void send(int code, const String& contentType, const String& content)
+    {
+      send(code, contentType.c_str(), content);
+    }
+
+    void send(int code)
+    {
+      send(code, "", "");
+    }
+
+  private:
+
+    typedef struct
+    {
+      WiFiClient    client;
+      bool          active;
+      uint16_t      length;                             // Bytes in buffer
+      uint16_t      headerEnd;                          // Bytes of the headers of the complete request, with CRLFCRLF
+      unsigned long requestStart;                       // First byte of the pending request
+      unsigned long lastActivity;
+      char          buffer[WM_PORTAL_BUFFER_SIZE + 1];  // +1 to terminate the body in place
+    } Slot;
+
+    typedef struct
+    {
+      String            uri;
+      HTTPMethod        method;
+      THandlerFunction  handler;
+    } Handler;
+
+    WiFiServer        server;
+    Slot              slots[WM_PORTAL_MAX_CLIENTS] = {};
+    uint8_t           nextSlot = 0;
+
+    Handler           handlers[WM_PORTAL_MAX_HANDLERS];
+    uint8_t           numHandlers = 0;
+    THandlerFunction  notFoundHandler;
+
+    // Current request, pointing into the slot buffer
+    Slot*             current = NULL;
+    WiFiClient        noClient;
+    bool              keepAlive = false;
+    HTTPMethod        currentMethod = HTTP_GET;
+    const char*       currentUri  = "";
+    const char*       currentHost = "";
+    const char*       argNames  [WM_PORTAL_MAX_ARGS];
+    const char*       argValues [WM_PORTAL_MAX_ARGS];
+    uint8_t           numArgs = 0;
+    String            responseHeaders;
+    size_t            contentLength = CONTENT_LENGTH_NOT_SET;
+
+    //////////////////////////////////////////////
+
+    void acceptClient(unsigned long now)
+    {
+      // NINA returns a connection having data to read, new or already open
+      WiFiClient newClient = server.available();
+
+      if (!newClient)
+        return;
+
+      int freeSlot = -1;
+      int idleSlot = -1;
+
+      for (uint8_t i = 0; i < WM_PORTAL_MAX_CLIENTS; i++)
+      {
+        if (!slots[i].active)
+        {
+          if (freeSlot < 0)
+            freeSlot = i;
+        }
+        else if (slots[i].client == newClient)
+        {
+          return;
+        }
+        else if ( (slots[i].length == 0) && ( (idleSlot < 0) || (slots[i].lastActivity < slots[idleSlot].lastActivity) ) )
+        {
+          idleSlot = i;
+        }
+      }
+
+      if (freeSlot < 0)
+      {
+        if (idleSlot < 0)
+        {
+          // All connections are in the middle of a request. The new one has to retry
+          WN_LOGDEBUG(F("PS:No free slot"));
+          newClient.stop();
+
+          return;
+        }
+
+        // Give the longest idle keep-alive connection away
+        closeSlot(slots[idleSlot]);
+        freeSlot = idleSlot;
+      }
+
+      Slot& slot = slots[freeSlot];
+
+      slot.client       = newClient;
+      slot.active       = true;
+      slot.length       = 0;
+      slot.lastActivity = now;
+
+      WN_LOGDEBUG1(F("PS:New client, slot="), freeSlot);
+    }
+
+    //////////////////////////////////////////////
+
+    void closeSlot(Slot& slot)
+    {
+      slot.client.stop();
+      slot.active = false;
+      slot.length = 0;
+    }
+
+    //////////////////////////////////////////////
+
+    void readSlot(Slot& slot, unsigned long now)
+    {
+      int available = slot.client.available();
+
+      if ( (available <= 0) || (slot.length >= WM_PORTAL_BUFFER_SIZE) )
+        return;
+
+      if (available > WM_PORTAL_BUFFER_SIZE - slot.length)
+        available = WM_PORTAL_BUFFER_SIZE - slot.length;
+
+      int received = slot.client.read((uint8_t *) slot.buffer + slot.length, available);
+
+      if (received > 0)
+      {
+        if (slot.length == 0)
+          slot.requestStart = now;
+
+        slot.length      += received;
+        slot.lastActivity = now;
+      }
+    }
+
+    //////////////////////////////////////////////
+
+    static bool isHeader(const char* line, const char* name)
+    {
+      uint8_t len = strlen(name);
+
+      return ( (strncasecmp(line, name, len) == 0) && (line[len] == ':') );
+    }
+
+    static const char* headerValue(const char* line)
+    {
+      line = strchr(line, ':') + 1;
+
+      while (*line == ' ')
+        line++;
+
+      return line;
+    }
+
+    // Length of the complete request (headers and body) at the start of the buffer, 0 if not yet complete,
+    // -1 if malformed, such as with a NUL byte in the headers, -2 if it can't fit into the buffer.
+    // Sets slot.headerEnd if complete
+    int completeRequestLength(Slot& slot)
+    {
+      uint16_t headerEnd = 0;
+
+      for (uint16_t i = 3; i < slot.length; i++)
+      {
+        if ( (slot.buffer[i] == '\n') && (slot.buffer[i - 1] == '\r') && (slot.buffer[i - 2] == '\n') && (slot.buffer[i - 3] == '\r') )
+        {
+          headerEnd = i + 1;
+          break;
+        }
+      }
+
+      if (headerEnd == 0)
+        return (slot.length >= WM_PORTAL_BUFFER_SIZE) ? -2 : 0;
+
+      // Headers are parsed as C strings
+      if (memchr(slot.buffer, 0, headerEnd))
+        return -1;
+
+      // Find Content-Length without modifying the buffer
+      unsigned long contentLength = 0;
+      const char*   line          = slot.buffer;
+
+      while (line < slot.buffer + headerEnd)
+      {
+        if (isHeader(line, "Content-Length"))
+        {
+          char* end;
+
+          contentLength = strtoul(headerValue(line), &end, 10);
+
+          if ( (*end != '\r') || (contentLength > WM_PORTAL_BUFFER_SIZE) )
+            return (*end != '\r') ? -1 : -2;
+        }
+
+        line = (const char *) memchr(line, '\n', slot.buffer + headerEnd - line) + 1;
+      }
+
+      if (headerEnd + contentLength > WM_PORTAL_BUFFER_SIZE)
+        return -2;
+
+      slot.headerEnd = headerEnd;
+
+      return (slot.length >= headerEnd + contentLength) ? (int) (headerEnd + contentLength) : 0;
+    }
+
+    // Terminate the line at line in place, at its "\r\n" or "\n" before end. Return the next line
+    static char* terminateLine(char* line, char* end)
+    {
+      char* lineEnd = (char *) memchr(line, '\n', end - line);
+
+      if (!lineEnd)
+        return end;
+
+      *lineEnd = 0;
+
+      if ( (lineEnd > line) && (lineEnd[-1] == '\r') )
+        lineEnd[-1] = 0;
+
+      return lineEnd + 1;
+    }
+
+    //////////////////////////////////////////////
+
+    static uint8_t hexValue(char c)
+    {
+      return (c <= '9') ? (c - '0') : ( (c | 0x20) - 'a' + 10 );
+    }
+
+    // Decode %xx and '+' in place
+    static void urlDecode(char* text)
+    {
+      char* out = text;
+
+      while (*text)
+      {
+        if ( (*text == '%') && isxdigit(text[1]) && isxdigit(text[2]) )
+        {
+          *out++ = (hexValue(text[1]) << 4) | hexValue(text[2]);
+          text  += 3;
+        }
+        else
+        {
+          *out++ = (*text == '+') ? ' ' : *text;
+          text++;
+        }
+      }
+
+      *out = 0;
+    }
+
+    void parseArgs(char* query)
+    {
+      while (query && *query && (numArgs < WM_PORTAL_MAX_ARGS))
+      {
+        char* next = strchr(query, '&');
+
+        if (next)
+          *next++ = 0;
+
+        char* value = strchr(query, '=');
+
+        if (value)
+          *value++ = 0;
+        else
+          value = query + strlen(query);
+
+        urlDecode(query);
+        urlDecode(value);
+
+        argNames[numArgs]  = query;
+        argValues[numArgs] = value;
+        numArgs++;
+
+        query = next;
+      }
+    }
+
+    //////////////////////////////////////////////
+
+    static HTTPMethod parseMethod(const char* name)
+    {
+      if (!strcmp(name, "GET"))
+        return HTTP_GET;
+      else if (!strcmp(name, "POST"))
+        return HTTP_POST;
+      else if (!strcmp(name, "PUT"))
+        return HTTP_PUT;
+      else if (!strcmp(name, "PATCH"))
+        return HTTP_PATCH;
+      else if (!strcmp(name, "DELETE"))
+        return HTTP_DELETE;
+      else if (!strcmp(name, "OPTIONS"))
+        return HTTP_OPTIONS;
+
+      return HTTP_ANY;
+    }
+
+    //////////////////////////////////////////////
+
+    void serveRequest(Slot& slot, uint16_t requestLength)
+    {
+      // Terminate the request in place. The byte after it may be the start of a pipelined request
+      char savedByte = slot.buffer[requestLength];
+      bool isForm    = false;
+
+      slot.buffer[requestLength] = 0;
+
+      // After the CRLFCRLF found by completeRequestLength(), with no NUL byte before
+      char* body = slot.buffer + slot.headerEnd;
+
+      current         = &slot;
+      numArgs         = 0;
+      currentHost     = "";
+      responseHeaders = "";
+
+      // Request line : METHOD URI HTTP/1.x
+      char* line = terminateLine(slot.buffer, body);
+
+      char* uri     = strchr(slot.buffer, ' ');
+      char* version = uri ? strchr(uri + 1, ' ') : NULL;
+
+      if (!version)
+      {
+        keepAlive = false;
+        send(400, "text/plain", "");
+        closeSlot(slot);
+        current = NULL;
+
+        return;
+      }
+
+      *uri++     = 0;
+      *version++ = 0;
+
+      currentMethod = parseMethod(slot.buffer);
+      keepAlive     = (strcmp(version, "HTTP/1.1") == 0);
+
+      // Headers
+      while (line < body - 2)
+      {
+        char* next = terminateLine(line, body);
+
+        if (strchr(line, ':'))
+        {
+          const char* value = headerValue(line);
+
+          if (isHeader(line, "Host"))
+            currentHost = value;
+          else if (isHeader(line, "Connection"))
+            keepAlive = (strcasecmp(value, "close") != 0) && (keepAlive || (strcasecmp(value, "keep-alive") == 0));
+          else if (isHeader(line, "Content-Type"))
+            isForm = (strncasecmp(value, "application/x-www-form-urlencoded", 33) == 0);
+        }
+
+        line = next;
+      }
+
+      char* query = strchr(uri, '?');
+
+      if (query)
+        *query++ = 0;
+
+      urlDecode(uri);
+      currentUri = uri;
+
+      parseArgs(query);
+
+      if (isForm)
+      {
+        parseArgs(body);
+      }
+      else if ( *body && (numArgs < WM_PORTAL_MAX_ARGS) )
+      {
+        // Any other body, such as JSON, is arg("plain") as in WiFiWebServer
+        argNames[numArgs]  = "plain";
+        argValues[numArgs] = body;
+        numArgs++;
+      }
+
+      WN_LOGDEBUG3(F("PS:"), currentUri, F(", args="), numArgs);
+
+      dispatch();
+
+      slot.lastActivity = millis();
+
+      if ( !slot.active || !keepAlive || !slot.client.connected() )
+      {
+        if (slot.active)
+          closeSlot(slot);
+      }
+      else
+      {
+        // Keep any pipelined request
+        slot.buffer[requestLength] = savedByte;
+        slot.length -= requestLength;
+        memmove(slot.buffer, slot.buffer + requestLength, slot.length);
+        slot.requestStart = slot.lastActivity;
+      }
+
+      current = NULL;
+    }
+
+    //////////////////////////////////////////////
+
+    void dispatch()
+    {
+      for (uint8_t i = 0; i < numHandlers; i++)
+      {
+        if ( (handlers[i].uri == currentUri) && ( (handlers[i].method == HTTP_ANY) || (handlers[i].method == currentMethod) ) )
+        {
+          handlers[i].handler();
+
+          return;
+        }
+      }
+
+      if (notFoundHandler)
+        notFoundHandler();
+      else
+        send(404, "text/plain", "Not found");
+    }
+
+    //////////////////////////////////////////////
+
+    static const char* statusText(int code)
+    {
+      switch (code)
+      {
+        case 200:
+          return "OK";
+        case 302:
+          return "Found";
+        case 400:
+          return "Bad Request";
+        case 404:
+          return "Not Found";
+        case 408:
+          return "Request Timeout";
+        case 413:
+          return "Payload Too Large";
+        default:
+          return (code < 300) ? "OK" : "Error";
+      }
+    }
+
+    //////////////////////////////////////////////
+
+    // Status line and headers, with the headers added by sendHeader(). Reserves room for extra bytes of content
+    String responseHeader(int code, const char* contentType, size_t length, size_t extra)
+    {
+      String response;
+
+      response.reserve(128 + responseHeaders.length() + extra);
+
+      response  = "HTTP/1.1 ";
+      response += code;
+      response += ' ';
+      response += statusText(code);
+      response += "\r\n";
+
+      if (contentType && *contentType)
+      {
+        response += "Content-Type: ";
+        response += contentType;
+        response += "\r\n";
+      }
+
+      response += "Content-Length: ";
+      response += length;
+      response += keepAlive ? "\r\nConnection: keep-alive\r\n" : "\r\nConnection: close\r\n";
+      response += responseHeaders;
+      response += "\r\n";
+
+      responseHeaders = "";
+
+      return response;
+    }
+
+    //////////////////////////////////////////////
+
+    bool writeData(const char* data, size_t length)
+    {
+      unsigned long start = millis();
+
+      while (length > 0)
+      {
+        size_t written = current->client.write((const uint8_t *) data, (length < WM_PORTAL_WRITE_UNIT) ? length : WM_PORTAL_WRITE_UNIT);
+
+        if (written == 0)
+        {
+          if ( !current->client.connected() || (millis() - start > WM_PORTAL_SEND_TIMEOUT) )
+          {
+            WN_LOGDEBUG(F("PS:Send timeout"));
+            keepAlive = false;
+
+            return false;
+          }
+
+          continue;
+        }
+
+        data   += written;
+        length -= written;
+      }
+
+      return true;
+    }
+};
+
+#endif    // USE_PORTAL_SERVER
+
+// Type of the Config Portal server used by the board-specific headers
+#if USE_PORTAL_SERVER
+  typedef WiFiNINA_PortalServer     WiFiNINA_WebServer;
+#else
+  typedef WiFiWebServer             WiFiNINA_WebServer;
+#endif
+
+#endif    // WiFiManager_NINA_Lite_PortalServer_h
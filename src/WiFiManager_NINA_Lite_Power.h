@@ -0,0 +1,83 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Power.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Idle of the board between the events of run(), and power save of the WiFi module.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Power_h
+#define WiFiManager_NINA_Lite_Power_h
+
+// New from v1.5.0
+// sleepUntilNextEvent(), called after run() in loop(), idles the MCU until run() has something to do : the next WiFi
+// status check, reconnect try or task of addTask(), at most WM_IDLE_MAX_SLEEP ms. What run() polls, the Config Portal
+// and the services of addService(), is polled every WM_IDLE_POLL_INTERVAL ms instead, as the WiFi module can't wake
+// the MCU. Serial received while idle is kept by its interrupt, and read by the next run().
+#ifndef USE_LOW_POWER_IDLE
+  #define USE_LOW_POWER_IDLE                false
+#endif
+
+#ifndef WM_IDLE_MAX_SLEEP
+  // ms. Max idle at once
+  #define WM_IDLE_MAX_SLEEP                 1000L
+#endif
+
+#ifndef WM_IDLE_POLL_INTERVAL
+  // ms. Max idle in Config Portal mode, or with services
+  #define WM_IDLE_POLL_INTERVAL             20L
+#endif
+
+// New from v1.5.0
+// true : the WiFi module sleeps between the beacons of the AP once connected, with WiFi.lowPowerMode(). Much less
+// current, but replies can take up to a beacon interval, about 100ms, longer. Also set by setWiFiPowerSave()
+#ifndef WM_WIFI_POWER_SAVE
+  #define WM_WIFI_POWER_SAVE                false
+#endif
+
+#if USE_LOW_POWER_IDLE
+
+#if defined(ARDUINO_ARCH_AVR)
+  #include <avr/sleep.h>
+#endif
+
+typedef struct
+{
+  uint32_t      sleeps;
+  unsigned long idleTime;         // ms idle in sleepUntilNextEvent()
+  unsigned long startTime;        // millis() when counting started. Active time is the rest of millis() - startTime
+} WiFiNINA_PowerStats;
+
+// Idle for ms
+inline void WiFiNINA_idle(unsigned long ms)
+{
+#if ( defined(ARDUINO_ARCH_NRF52) || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED) )
+  // delay() of the RTOS or SDK already sleeps, without tick, until the time is up
+  delay(ms);
+#else
+  unsigned long startTime = millis();
+
+  while (millis() - startTime < ms)
+  {
+  #if defined(ARDUINO_ARCH_AVR)
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+  #elif defined(__arm__)
+    __asm__ volatile ("wfi");
+  #else
+    yield();
+  #endif
+  }
+#endif
+}
+
+#endif    // USE_LOW_POWER_IDLE
+
+#endif    // WiFiManager_NINA_Lite_Power_h
@@ -8,7 +8,7 @@
 
   Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
   Licensed under MIT license
-  Version: 1.4.1
+  Version: 1.5.0
 
   Version Modified By   Date        Comments
   ------- -----------  ----------   -----------
@@ -29,6 +29,7 @@
   1.3.1   K Hoang      15/05/2021  Fix createHTML bug.
   1.4.0   K Hoang      28/05/2021  Add support to Nano_RP2040_Connect, RASPBERRY_PI_PICO using Arduino mbed or Arduino-pico core
   1.4.1   K Hoang      12/10/2021 Update `platform.ini` and `library.json`
+  1.5.0   K Hoang      19/10/2026  Add optional storage, Config Portal, reconnect, MQTT and power features. See changelog
   **********************************************************************************************************************************/
 
 #ifndef WiFiManager_NINA_Lite_RP2040_h
@@ -44,7 +45,7 @@
   #error This code is intended to run on the RP2040 platform! Please check your Tools->Board setting.  
 #endif
 
-#define WIFIMANAGER_NINA_LITE_VERSION        "WiFiManager_NINA_Lite v1.4.1"
+#define WIFIMANAGER_NINA_LITE_VERSION        "WiFiManager_NINA_Lite v1.5.0"
 
 #include <WiFiWebServer.h>
 
@@ -56,6 +57,13 @@
 //////////////////////////////////////////
 
 #include <WiFiManager_NINA_Lite_Debug.h>
+#include <WiFiManager_NINA_Lite_PortalServer.h>
+#include <WiFiManager_NINA_Lite_DNSServer.h>
+#include <WiFiManager_NINA_Lite_Backoff.h>
+#include <WiFiManager_NINA_Lite_Service.h>
+#include <WiFiManager_NINA_Lite_Scheduler.h>
+#include <WiFiManager_NINA_Lite_Power.h>
+#include <WiFiManager_NINA_Lite_Spool.h>
 
 #ifndef USING_CUSTOMS_STYLE
   #define USING_CUSTOMS_STYLE     false
@@ -107,7 +115,11 @@
 #define DOUBLERESETDETECTOR_DEBUG     false
 #endif
 
-#include <DoubleResetDetector_Generic.h>      //https://github.com/khoih-prog/DoubleResetDetector_Generic
+#include <WiFiManager_NINA_Lite_NoInit.h>
+
+#if !USE_NOINIT_RAM_FLAGS
+  #include <DoubleResetDetector_Generic.h>      //https://github.com/khoih-prog/DoubleResetDetector_Generic
+#endif
 
 // Number of seconds after reset during which a
 // subseqent reset will be considered a double reset.
@@ -116,7 +128,11 @@
 // RTC Memory Address for the DoubleResetDetector_Generic to use
 #define DRD_ADDRESS 0
 
-DoubleResetDetector_Generic* drd;
+#if USE_NOINIT_RAM_FLAGS
+  WiFiNINA_NoInitDRD* drd;
+#else
+  DoubleResetDetector_Generic* drd;
+#endif
 
 ///////// NEW for DRD /////////////
 
@@ -131,7 +147,12 @@ typedef struct
   char displayName    [MAX_DISPLAY_NAME_LEN + 1];
   char *pdata;
   uint8_t maxlen;
+  uint8_t type;               // New from v1.5.0. WM_ITEM_TEXT (default) or a typed item
+  const char* options;        // New from v1.5.0. Names for WM_ITEM_ENUM, such as "off|low|high"
 } MenuItem;
+
+#include <WiFiManager_NINA_Lite_MenuItem.h>
+#include <WiFiManager_NINA_Lite_StaticIP.h>
 //
 
 #if USE_DYNAMIC_PARAMETERS
@@ -140,6 +161,8 @@ typedef struct
   extern uint16_t NUM_MENU_ITEMS;
   extern MenuItem myMenuItems [];
   bool *menuItemUpdated = NULL;
+  // New from v1.5.0. Positions of myMenuItems sorted by id, for Config Portal key lookup
+  uint16_t *menuItemIndex = NULL;
 #else
   #warning Not using Dynamic Parameters
 #endif
@@ -157,7 +180,7 @@ typedef struct
 #define NUM_WIFI_CREDENTIALS      2
 
 // Configurable items besides fixed Header, just add board_name 
-#define NUM_CONFIGURABLE_ITEMS    ( ( 2 * NUM_WIFI_CREDENTIALS ) + 1 )
+#define NUM_CONFIGURABLE_ITEMS    ( ( 2 * NUM_WIFI_CREDENTIALS ) + 1 + WM_NUM_STATIC_IP_ITEMS )
 ////////////////
 
 #define HEADER_MAX_LEN            16
@@ -168,6 +191,12 @@ typedef struct Configuration
   char header         [HEADER_MAX_LEN];
   WiFi_Credentials  WiFi_Creds  [NUM_WIFI_CREDENTIALS];
   char board_name     [BOARD_NAME_MAX_LEN];
+#if USE_STATIC_IP_CONFIG
+  WiFiNINA_IPConfig   staticIP;     // New from v1.5.0
+#endif
+#if USE_STICKY_DHCP
+  WiFiNINA_DHCPLease  dhcpLease;    // New from v1.5.0
+#endif
   int  checkSum;
 } WiFiNINA_Configuration;
 
@@ -178,46 +207,17 @@ uint16_t CONFIG_DATA_SIZE = sizeof(WiFiNINA_Configuration);
 extern bool LOAD_DEFAULT_CONFIG_DATA;
 extern WiFiNINA_Configuration defaultConfig;
 
+#include <WiFiManager_NINA_Lite_Storage.h>
+#include <WiFiManager_NINA_Lite_Json.h>
+#include <WiFiManager_NINA_Lite_SerialConfig.h>
+
 // -- HTML page fragments
 
 const char WIFININA_HTML_HEAD_START[] /*PROGMEM*/ = "<!DOCTYPE html><html><head><title>RP2040_WM_NINA_Lite</title>";
 
-const char WIFININA_HTML_HEAD_STYLE[] /*PROGMEM*/ = "<style>div,input,select{padding:5px;font-size:1em;}input,select{width:95%;}body{text-align:center;}button{background-color:#16A1E7;color:#fff;line-height:2.4rem;font-size:1.2rem;width:100%;}fieldset{border-radius:0.3rem;margin:0px;}</style>";
-
-const char WIFININA_HTML_HEAD_END[]   /*PROGMEM*/ = "</head><div style='text-align:left;display:inline-block;min-width:260px;'>\
-<fieldset><div><label>*WiFi SSID</label><div>[[input_id]]</div></div>\
-<div><label>*PWD (8+ chars)</label><input value='[[pw]]' id='pw'><div></div></div>\
-<div><label>*WiFi SSID1</label><div>[[input_id1]]</div></div>\
-<div><label>*PWD1 (8+ chars)</label><input value='[[pw1]]' id='pw1'><div></div></div></fieldset>\
-<fieldset><div><label>Board Name</label><input value='[[nm]]' id='nm'><div></div></div></fieldset>";	// DO NOT CHANGE THIS STRING EVER!!!!
-
-const char WIFININA_HTML_INPUT_ID[]   /*PROGMEM*/ = "<input value='[[id]]' id='id'>";
-const char WIFININA_HTML_INPUT_ID1[]  /*PROGMEM*/ = "<input value='[[id1]]' id='id1'>";
-
-const char WIFININA_FLDSET_START[]  /*PROGMEM*/ = "<fieldset>";
-const char WIFININA_FLDSET_END[]    /*PROGMEM*/ = "</fieldset>";
-const char WIFININA_HTML_PARAM[]    /*PROGMEM*/ = "<div><label>{b}</label><input value='[[{v}]]'id='{i}'><div></div></div>";
-const char WIFININA_HTML_BUTTON[]   /*PROGMEM*/ = "<button onclick=\"sv()\">Save</button></div>";
-const char WIFININA_HTML_SCRIPT[]   /*PROGMEM*/ = "<script id=\"jsbin-javascript\">\
-function udVal(key,val){var request=new XMLHttpRequest();var url='/?key='+key+'&value='+encodeURIComponent(val);\
-request.open('GET',url,false);request.send(null);}\
-function sv(){udVal('id',document.getElementById('id').value);udVal('pw',document.getElementById('pw').value);\
-udVal('id1',document.getElementById('id1').value);udVal('pw1',document.getElementById('pw1').value);\
-udVal('nm',document.getElementById('nm').value);";
-
-const char WIFININA_HTML_SCRIPT_ITEM[]  /*PROGMEM*/ = "udVal('{d}',document.getElementById('{d}').value);";
-const char WIFININA_HTML_SCRIPT_END[]   /*PROGMEM*/ = "alert('Updated');}</script>";
-const char WIFININA_HTML_END[]          /*PROGMEM*/ = "</html>";
-
-#if SCAN_WIFI_NETWORKS
-const char WIFININA_SELECT_START[]      /*PROGMEM*/ = "<select id=";
-const char WIFININA_SELECT_END[]        /*PROGMEM*/ = "</select>";
-const char WIFININA_DATALIST_START[]    /*PROGMEM*/ = "<datalist id=";
-const char WIFININA_DATALIST_END[]      /*PROGMEM*/ = "</datalist>";
-const char WIFININA_OPTION_START[]      /*PROGMEM*/ = "<option>";
-const char WIFININA_OPTION_END[]        /*PROGMEM*/ = "";			// "</option>"; is not required
-const char WIFININA_NO_NETWORKS_FOUND[] /*PROGMEM*/ = "No suitable WiFi networks available!";
-#endif
+// New from v1.5.0. Other fragments, style and script, shared by all boards. Generated by utils/wm_html_build.py
+#include <WiFiManager_NINA_Lite_HTML.h>
+#include <WiFiManager_NINA_Lite_Page.h>
 
 //////////////////////////////////////////
 
@@ -278,6 +278,14 @@ class WiFiManager_NINA_Lite
 
     ~WiFiManager_NINA_Lite()
     {
+#if USE_CAPTIVE_PORTAL_DNS
+      if (dnsServer)
+      {
+        dnsServer->stop();
+        delete dnsServer;
+      }
+#endif
+
       if (server)
       {
         delete server;
@@ -342,10 +350,22 @@ class WiFiManager_NINA_Lite
       }
       
       WN_LOGERROR1(F("Hostname="), RFC952_hostname);
+
+#if USE_RECONNECT_BACKOFF
+      // New from v1.5.0. Different on each device, so that devices losing the same AP don't retry together
+      uint8_t macAddress[6];
+      
+      WiFi.macAddress(macAddress);
+      reconnectBackoff.seed(macAddress, sizeof(macAddress));
+#endif
       //////
       
       //// New DRD ////
-      drd = new DoubleResetDetector_Generic(DRD_TIMEOUT, DRD_ADDRESS);  
+#if USE_NOINIT_RAM_FLAGS
+      drd = new WiFiNINA_NoInitDRD(DRD_TIMEOUT);
+#else
+      drd = new DoubleResetDetector_Generic(DRD_TIMEOUT, DRD_ADDRESS);
+#endif
       bool noConfigPortal = true;
    
       if (drd->detectDoubleReset())
@@ -426,6 +446,18 @@ class WiFiManager_NINA_Lite
   #define RESET_IF_CONFIG_TIMEOUT   true
 #endif
 
+// New from v1.5.0
+// After Save in Config Portal, stop Config Portal AP and connect with the new Config Data, instead of delay then reset.
+// Reset only if no WiFi can be connected
+#ifndef USE_LIVE_RECONFIG
+  #define USE_LIVE_RECONFIG         false
+#endif
+
+#ifndef WM_LIVE_RECONFIG_DELAY
+  // ms. Config Portal keeps serving for this time after Save, so that the last responses go out
+  #define WM_LIVE_RECONFIG_DELAY    200L
+#endif
+
 #ifndef CONFIG_TIMEOUT_RETRYTIMES_BEFORE_RESET
   #define CONFIG_TIMEOUT_RETRYTIMES_BEFORE_RESET          10
 #else
@@ -459,12 +491,40 @@ class WiFiManager_NINA_Lite
       // consider the next reset as a double reset.
       drd->loop();
       //// New DRD ////
+
+#if USE_STICKY_DHCP
+      // New from v1.5.0. Lease kept or dropped by connectMultiWiFi(). Not while Config Portal may be changing Config Data
+      if (leaseChanged && !configuration_mode)
+      {
+        leaseChanged = false;
+        saveConfigData();
+      }
+#endif
+
+#if USE_SERIAL_CONFIG
+      // New from v1.5.0. Requests of a provisioning host, in both normal and Config Portal mode
+      handleSerialConfig();
+#endif
+
+#if USE_LIVE_RECONFIG
+      // New from v1.5.0. Config Data saved in Config Portal
+      if ( reconfigurePending && (millis() - reconfigureTime >= WM_LIVE_RECONFIG_DELAY) )
+      {
+        reconfigure();
+
+        return;
+      }
+#endif
          
       if ( !configuration_mode && (millis() > checkstatus_timeout) )
       {       
         if (WiFi.status() == WL_CONNECTED)
         {
           wifi_connected = true;
+
+#if USE_RECONNECT_BACKOFF
+          reconnectBackoff.succeeded();
+#endif
         }
         else
         {
@@ -481,8 +541,22 @@ class WiFiManager_NINA_Lite
         }
         
         checkstatus_timeout = millis() + WIFI_STATUS_CHECK_INTERVAL;
+
+#if USE_LOW_POWER_IDLE
+        nextStatusCheck = checkstatus_timeout;
+#endif
       }    
 
+#if USE_RUN_SERVICES
+      // New from v1.5.0. Services added by addService(), such as the MQTT session
+      runServices();
+#endif
+
+#if USE_TASK_SCHEDULER
+      // New from v1.5.0. Tasks added by addTask(), in both normal and Config Portal mode
+      scheduler.runTasks(WM_TASK_TIME_SLICE);
+#endif
+
       // Lost connection in running. Give chance to reconfig.
       if ( !wifi_connected )
       {
@@ -497,11 +571,24 @@ class WiFiManager_NINA_Lite
             //WN_LOGDEBUG(F("r:handleClient"));
             server->handleClient();
           }
+
+#if USE_CAPTIVE_PORTAL_DNS
+          if (dnsServer)
+          {
+            dnsServer->processRequests();
+          }
+#endif
            
           return;
         }
         else
         {
+#if USE_RECONNECT_BACKOFF
+          // New from v1.5.0. Only at the scheduled time, not in every run()
+          if ( !reconnectBackoff.due(millis()) )
+            return;
+#endif
+
 #if RESET_IF_CONFIG_TIMEOUT
           // If we're here but still in configuration_mode, permit running TIMES_BEFORE_RESET times before reset hardware
           // to permit user another chance to config.
@@ -526,7 +613,19 @@ class WiFiManager_NINA_Lite
             if (connectMultiWiFi(RETRY_TIMES_RECONNECT_WIFI))
             {
               WN_LOGERROR(F("r:WOK"));
+
+#if USE_RECONNECT_BACKOFF
+              reconnectBackoff.succeeded();
+#endif
+            }
+#if USE_RECONNECT_BACKOFF
+            else
+            {
+              reconnectBackoff.failed(millis());
+              
+              WN_LOGERROR3(F("r:NextReconW="), reconnectBackoff.getDelay(), F(",Try#"), reconnectBackoff.getAttempts());
             }
+#endif
           }
         }
       }
@@ -590,6 +689,18 @@ class WiFiManager_NINA_Lite
     {
       static_IP = ip;
     }
+
+    //////////////////////////////////////////////
+
+    // New from v1.5.0
+    void setSTAStaticIPConfig(IPAddress ip, IPAddress gw, IPAddress sn = IPAddress(255, 255, 255, 0),
+                              IPAddress dns = IPAddress(0, 0, 0, 0))
+    {
+      static_IP   = ip;
+      static_GW   = gw;
+      static_SN   = sn;
+      static_DNS  = dns;
+    }
     
     //////////////////////////////////////////////
     
@@ -656,8 +767,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS      
       for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
       {
-        // Actual size of pdata is [maxlen + 1]
-        memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+        WiFiNINA_clearMenuItem(myMenuItems[i]);
       }
 #endif
 
@@ -672,6 +782,157 @@ class WiFiManager_NINA_Lite
     }
     
     //////////////////////////////////////////////
+
+#if USE_RECONNECT_BACKOFF
+    // New from v1.5.0. Min and max wait between reconnect tries after WiFi is lost, in ms
+    void setReconnectBackoff(unsigned long baseDelay, unsigned long maxDelay)
+    {
+      reconnectBackoff.setDelays(baseDelay, maxDelay);
+    }
+    
+    //////////////////////////////////////////////
+    
+    // getAttempts(), getDelay() and getTimeToNextAttempt(millis()) of the reconnect scheduler
+    const WiFiNINA_Backoff& getReconnectBackoff()
+    {
+      return reconnectBackoff;
+    }
+    
+    //////////////////////////////////////////////
+#endif
+
+#if USE_RUN_SERVICES
+    // New from v1.5.0. Run service in each run(), up to WM_MAX_SERVICES
+    bool addService(WiFiNINA_Service* service)
+    {
+      if (numServices >= WM_MAX_SERVICES)
+        return false;
+
+      services[numServices++] = service;
+
+      return true;
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_TASK_SCHEDULER
+    // New from v1.5.0. Run function every period ms from run(), up to WM_MAX_TASKS. Return the task, or -1
+    int8_t addTask(WiFiNINA_TaskFunction function, unsigned long period, unsigned long deadline = 0,
+                   unsigned long budget = 0)
+    {
+      return scheduler.addTask(function, period, deadline, budget);
+    }
+
+    // setTaskEnabled(), and taskStats() with runs, overruns, missed and skipped of each task
+    WiFiNINA_Scheduler& getScheduler()
+    {
+      return scheduler;
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_LOW_POWER_IDLE
+    // New from v1.5.0
+    // ms until run() has something to do, at most WM_IDLE_MAX_SLEEP, or WM_IDLE_POLL_INTERVAL if it polls
+    unsigned long getTimeToNextEvent()
+    {
+      unsigned long now   = millis();
+      unsigned long wait  = WM_IDLE_MAX_SLEEP;
+
+      if (configuration_mode)
+      {
+        // Config Portal
+        wait = WM_IDLE_POLL_INTERVAL;
+      }
+      else
+      {
+        if ( (long) (nextStatusCheck - now) < 0 )
+          return 0;
+
+        if (nextStatusCheck - now + 1 < wait)
+          wait = nextStatusCheck - now + 1;
+
+        if (!wifi_connected)
+        {
+#if USE_RECONNECT_BACKOFF
+          if (reconnectBackoff.getTimeToNextAttempt(now) < wait)
+            wait = reconnectBackoff.getTimeToNextAttempt(now);
+#else
+          // Reconnect in each run()
+          return 0;
+#endif
+        }
+      }
+
+#if USE_LIVE_RECONFIG
+      if (reconfigurePending)
+      {
+        if (now - reconfigureTime >= WM_LIVE_RECONFIG_DELAY)
+          return 0;
+
+        if (WM_LIVE_RECONFIG_DELAY - (now - reconfigureTime) < wait)
+          wait = WM_LIVE_RECONFIG_DELAY - (now - reconfigureTime);
+      }
+#endif
+
+#if USE_RUN_SERVICES
+      if ( (numServices > 0) && (wait > WM_IDLE_POLL_INTERVAL) )
+        wait = WM_IDLE_POLL_INTERVAL;
+#endif
+
+#if USE_TASK_SCHEDULER
+      wait = scheduler.getTimeToNextTask(now, wait);
+#endif
+
+      return wait;
+    }
+
+    // Idle the MCU until run() has something to do. Call after run() in loop()
+    void sleepUntilNextEvent()
+    {
+      unsigned long wait = getTimeToNextEvent();
+
+      if (wait == 0)
+        return;
+
+      unsigned long startTime = millis();
+
+      WiFiNINA_idle(wait);
+
+      powerStats.sleeps++;
+      powerStats.idleTime += millis() - startTime;
+    }
+
+    // Idle time against millis() - startTime, the duty cycle to estimate the energy used
+    const WiFiNINA_PowerStats& getPowerStats()
+    {
+      return powerStats;
+    }
+
+    void resetPowerStats()
+    {
+      powerStats.sleeps     = 0;
+      powerStats.idleTime   = 0;
+      powerStats.startTime  = millis();
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+    // New from v1.5.0. As WM_WIFI_POWER_SAVE, now and after each WiFi connection
+    void setWiFiPowerSave(bool enable)
+    {
+      wifiPowerSave = enable;
+
+      if (enable)
+        WiFi.lowPowerMode();
+      else
+        WiFi.noLowPowerMode();
+    }
+
+    //////////////////////////////////////////////
     
     // Forced CP => Flag = 0xBEEFBEEF. Else => No forced CP
     // Flag to be stored at (EEPROM_START + DRD_FLAG_DATA_SIZE + CONFIG_DATA_SIZE) 
@@ -820,10 +1081,64 @@ class WiFiManager_NINA_Lite
   private:
     String ipAddress = "0.0.0.0";
 
-    WiFiWebServer* server = NULL;
+    WiFiNINA_WebServer* server = NULL;
+
+#if USE_CAPTIVE_PORTAL_DNS
+    // New from v1.5.0
+    WiFiNINA_DNSServer* dnsServer = NULL;
+#endif
+
+#if USE_SERIAL_CONFIG
+    // New from v1.5.0
+    WiFiNINA_SerialConfig serialConfig;
+#endif
+
+#if USE_RECONNECT_BACKOFF
+    // New from v1.5.0
+    WiFiNINA_Backoff reconnectBackoff;
+#endif
+
+#if USE_RUN_SERVICES
+    // New from v1.5.0
+    WiFiNINA_Service* services[WM_MAX_SERVICES];
+    uint8_t           numServices = 0;
+#endif
+
+#if USE_TASK_SCHEDULER
+    // New from v1.5.0
+    WiFiNINA_Scheduler scheduler;
+#endif
+
+#if USE_LOW_POWER_IDLE
+    // New from v1.5.0
+    WiFiNINA_PowerStats powerStats      = { 0, 0, 0 };
+    unsigned long       nextStatusCheck = 0;
+#endif
+
+    // New from v1.5.0
+    bool wifiPowerSave = WM_WIFI_POWER_SAVE;
     
     bool configuration_mode = false;
 
+    // Config Portal items received since the last save
+    int  number_items_Updated = 0;
+    bool id_Updated           = false;
+    bool pw_Updated           = false;
+    bool id1_Updated          = false;
+    bool pw1_Updated          = false;
+    bool nm_Updated           = false;
+
+#if USE_STATIC_IP_CONFIG
+    // One bit per ip, gw, sn, dns
+    uint8_t ip_Updated        = 0;
+#endif
+
+#if USE_LIVE_RECONFIG
+    // New from v1.5.0
+    bool          reconfigurePending  = false;
+    unsigned long reconfigureTime     = 0;
+#endif
+
     unsigned long configTimeout;
     bool hadConfigData = false;
     
@@ -844,6 +1159,16 @@ class WiFiManager_NINA_Lite
     String portal_pass = "";
 
     IPAddress static_IP   = IPAddress(0, 0, 0, 0);
+    IPAddress static_GW   = IPAddress(0, 0, 0, 0);
+    IPAddress static_SN   = IPAddress(0, 0, 0, 0);
+    IPAddress static_DNS  = IPAddress(0, 0, 0, 0);
+
+#if USE_STICKY_DHCP
+    // The module keeps a reused lease as static IP config until WiFi.end()
+    bool leaseApplied = false;
+    // Lease to be written by run()
+    bool leaseChanged = false;
+#endif
     
     /////////////////////////////////////
     
@@ -867,7 +1192,7 @@ class WiFiManager_NINA_Lite
 #if SCAN_WIFI_NETWORKS
   int WiFiNetworksFound = 0;		// Number of SSIDs found by WiFi scan, including low quality and duplicates
   int *indices;					        // WiFi network data, filled by scan (SSID, BSSID)
-  String ListOfSSIDs = "";		  // List of SSIDs found by scan, in HTML <option> format
+  String ListOfSSIDs = "";		  // List of SSIDs found by scan, one per line, served by /scan
 #endif
 
     //////////////////////////////////////
@@ -910,7 +1235,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS     
       for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
       {
-        WN_LOGERROR5("i=", i, ",id=", myMenuItems[i].id, ",data=", myMenuItems[i].pdata);
+        WN_LOGERROR5("i=", i, ",id=", myMenuItems[i].id, ",data=", WiFiNINA_menuItemToString(myMenuItems[i]));
       }
 #endif               
     }
@@ -947,10 +1272,29 @@ class WiFiManager_NINA_Lite
 #define  CONFIG_PORTAL_FILENAME           ("/fs/wm_cp.dat")
 #define  CONFIG_PORTAL_FILENAME_BACKUP    ("/fs/wm_cp.bak")
 
+#if USE_PACKED_CONFIG_FILE
+// New from v1.5.0
+#define  CONFIG_PACKED_FILENAME           ("/fs/wm_packed.dat")
+#endif
+
+#if USE_CONFIG_AB_SLOTS
+// New from v1.5.0
+#define  CONFIG_SLOT_FILENAME_0           ("/fs/wm_slot0.dat")
+#define  CONFIG_SLOT_FILENAME_1           ("/fs/wm_slot1.dat")
+#endif
+
     //////////////////////////////////////////////
     
     void saveForcedCP(uint32_t value)
     {
+#if USE_PACKED_CONFIG_FILE
+      // The flag is kept in the packed file header. Don't rewrite the file for an unchanged flag
+      if (packedForcedCPFlag != value)
+      {
+        packedForcedCPFlag = value;
+        savePackedData();
+      }
+#else
       // Mbed RP2040 code
       FILE *file = fopen(CONFIG_PORTAL_FILENAME, "w");
       
@@ -986,6 +1330,7 @@ class WiFiManager_NINA_Lite
       {
         WN_LOGERROR(F("failed"));
       }
+#endif
     }
     
     //////////////////////////////////////////////
@@ -995,6 +1340,15 @@ class WiFiManager_NINA_Lite
       uint32_t readForcedConfigPortalFlag = isPersistent? FORCED_PERS_CONFIG_PORTAL_FLAG_DATA : FORCED_CONFIG_PORTAL_FLAG_DATA;
   
       WN_LOGERROR(isPersistent ? F("setForcedCP Persistent") : F("setForcedCP non-Persistent"));
+
+#if USE_NOINIT_RAM_FLAGS
+      // New from v1.5.0. Only the persistent flag has to survive a power cycle
+      if (!isPersistent)
+      {
+        WiFiNINA_setNoInitForcedCP(readForcedConfigPortalFlag);
+        return;
+      }
+#endif
       
       saveForcedCP(readForcedConfigPortalFlag);
     }
@@ -1003,6 +1357,21 @@ class WiFiManager_NINA_Lite
     
     void clearForcedCP()
     {
+#if USE_NOINIT_RAM_FLAGS
+      WiFiNINA_setNoInitForcedCP(0);
+      
+      // Write to storage only if a (persistent) flag is stored there
+      bool persistent   = persForcedConfigPortal;
+      bool storedFlag   = isForcedCP();
+      
+      persForcedConfigPortal = persistent;
+      
+      if (!storedFlag)
+      {
+        return;
+      }
+#endif
+
       uint32_t readForcedConfigPortalFlag = 0;
    
       WN_LOGERROR(F("clearForcedCP"));
@@ -1015,9 +1384,22 @@ class WiFiManager_NINA_Lite
     bool isForcedCP()
     {
       uint32_t readForcedConfigPortalFlag;
+
+#if USE_NOINIT_RAM_FLAGS
+      // New from v1.5.0. Non-persistent forced CP is kept in no-init RAM
+      if (WiFiNINA_getNoInitForcedCP() == FORCED_CONFIG_PORTAL_FLAG_DATA)
+      {
+        persForcedConfigPortal = false;
+        return true;
+      }
+#endif
     
       WN_LOGDEBUG(F("Check if isForcedCP"));
       
+#if USE_PACKED_CONFIG_FILE
+      // Already read from the packed file header by getConfigData()
+      readForcedConfigPortalFlag = packedForcedCPFlag;
+#else
       FILE *file = fopen(CONFIG_PORTAL_FILENAME, "r");
       
       WN_LOGDEBUG(F("LoadCPFile "));
@@ -1042,8 +1424,8 @@ class WiFiManager_NINA_Lite
       fread((uint8_t *) &readForcedConfigPortalFlag, 1, sizeof(readForcedConfigPortalFlag), file);        
       fclose(file);
       WN_LOGDEBUG(F("OK"));
-      
-      
+#endif
+
       // Return true if forced CP (0xDEADBEEF read at offset EPROM_START + DRD_FLAG_DATA_SIZE + CONFIG_DATA_SIZE)
       // => set flag noForcedConfigPortal = false     
       if (readForcedConfigPortalFlag == FORCED_CONFIG_PORTAL_FLAG_DATA)
@@ -1201,8 +1583,7 @@ class WiFiManager_NINA_Lite
         uint8_t * _pointer = (uint8_t *) myMenuItems[i].pdata;
         totalDataSize += myMenuItems[i].maxlen;
 
-        // Actual size of pdata is [maxlen + 1]
-        memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+        WiFiNINA_clearMenuItem(myMenuItems[i]);
         
         // Redundant, but to be sure correct position
         fseek(file, offset, SEEK_SET);
@@ -1210,7 +1591,7 @@ class WiFiManager_NINA_Lite
         
         offset += myMenuItems[i].maxlen;        
     
-        WN_LOGDEBUG3(F("CrR:pdata="), myMenuItems[i].pdata, F(",len="), myMenuItems[i].maxlen);         
+        WN_LOGDEBUG3(F("CrR:pdata="), WiFiNINA_menuItemToString(myMenuItems[i]), F(",len="), myMenuItems[i].maxlen);         
                
         for (uint16_t j = 0; j < myMenuItems[i].maxlen; j++,_pointer++)
         {         
@@ -1250,7 +1631,7 @@ class WiFiManager_NINA_Lite
       {       
         uint8_t* _pointer = (uint8_t *) myMenuItems[i].pdata;
        
-        WN_LOGDEBUG3(F("CW1:pdata="), myMenuItems[i].pdata, F(",len="), myMenuItems[i].maxlen);
+        WN_LOGDEBUG3(F("CW1:pdata="), WiFiNINA_menuItemToString(myMenuItems[i]), F(",len="), myMenuItems[i].maxlen);
         
         if (file)
         {
@@ -1286,6 +1667,8 @@ class WiFiManager_NINA_Lite
       WN_LOGDEBUG1(F("CrWCSum=0x"), String(checkSum, HEX));
       
       // Trying open redundant Auth file
+      checkSum = 0;
+      
       file = fopen(CREDENTIALS_FILENAME_BACKUP, "w");
       
       WN_LOGDEBUG(F("SaveBkUpCredFile "));
@@ -1296,7 +1679,7 @@ class WiFiManager_NINA_Lite
       {       
         uint8_t* _pointer = (uint8_t *) myMenuItems[i].pdata;
      
-        WN_LOGDEBUG3(F("CW2:pdata="), myMenuItems[i].pdata, F(",len="), myMenuItems[i].maxlen);
+        WN_LOGDEBUG3(F("CW2:pdata="), WiFiNINA_menuItemToString(myMenuItems[i]), F(",len="), myMenuItems[i].maxlen);
         
         if (file)
         {
@@ -1390,83 +1773,460 @@ class WiFiManager_NINA_Lite
     
     //////////////////////////////////////////////
 
-    bool loadConfigData()
+#if USE_CONFIG_AB_SLOTS
+
+    // New from v1.5.0
+    uint8_t   activeSlot        = 0;
+    uint32_t  activeGeneration  = 0;
+    
+    //////////////////////////////////////////////
+    
+    const char* slotFileName(uint8_t slot)
     {
-      WN_LOGDEBUG(F("LoadCfgFile "));
+      return (slot == 0) ? CONFIG_SLOT_FILENAME_0 : CONFIG_SLOT_FILENAME_1;
+    }
+    
+    //////////////////////////////////////////////
+    
+    bool loadSlotData()
+    {
+      WiFiNINA_SlotHeader header[WM_NUM_SLOTS];
+      uint8_t   order[WM_NUM_SLOTS];
+      uint16_t  dataSize = WiFiNINA_slotDataSize();
       
-      // file existed
-      FILE *file = fopen(CONFIG_FILENAME, "r");
+      memset(header, 0, sizeof(header));
       
-      if (!file)
+      // Only the slot headers are read to select the newest slot
+      for (uint8_t slot = 0; slot < WM_NUM_SLOTS; slot++)
       {
-        WN_LOGDEBUG(F("failed"));
-
-        // Trying open redundant config file
-        file = fopen(CONFIG_FILENAME_BACKUP, "r");
+        FILE *file = fopen(slotFileName(slot), "r");
         
-        WN_LOGDEBUG(F("LoadBkUpCfgFile "));
-
-        if (!file)
+        if (file)
         {
-          WN_LOGDEBUG(F("failed"));
-          return false;
+          fread((uint8_t *) &header[slot], 1, sizeof(WiFiNINA_SlotHeader), file);
+          fclose(file);
         }
       }
-     
-      fseek(file, 0, SEEK_SET);
-      fread((uint8_t *) &WIFININA_config, 1, sizeof(WIFININA_config), file);
-      fclose(file);
-
-      WN_LOGDEBUG(F("OK"));
       
-      return isWiFiConfigValid();
-    }
-    
-    //////////////////////////////////////////////
-
-    void saveConfigData()
-    {
-      WN_LOGDEBUG(F("SaveCfgFile "));
-
-      int calChecksum = calcChecksum();
-      WIFININA_config.checkSum = calChecksum;
-      WN_LOGDEBUG1(F("WCSum=0x"), String(calChecksum, HEX));
+      uint8_t numValidSlots = WiFiNINA_orderSlots(header, dataSize, order);
       
-      FILE *file = fopen(CONFIG_FILENAME, "w");
-
-      if (file)
+      if (numValidSlots == 0)
       {
-        fseek(file, 0, SEEK_SET);
-        fwrite((uint8_t *) &WIFININA_config, 1, sizeof(WIFININA_config), file);
-        fclose(file);
-        
-        WN_LOGDEBUG(F("OK"));
+        WN_LOGERROR(F("No valid Config Slot"));
+        return false;
       }
-      else
+      
+      uint8_t* data = new uint8_t[dataSize];
+      
+      if (data == nullptr)
       {
-        WN_LOGDEBUG(F("failed"));
+        WN_LOGERROR(F("Can't alloc Slot buffer"));
+        return false;
       }
       
-      WN_LOGDEBUG(F("SaveBkUpCfgFile "));
-      
-      // Trying open redundant Auth file
-      file = fopen(CONFIG_FILENAME_BACKUP, "w");
-
-      if (file)
+      // Newest slot first, fall back to the older one if its data is corrupted
+      for (uint8_t i = 0; i < numValidSlots; i++)
       {
-        fseek(file, 0, SEEK_SET);
-        fwrite((uint8_t *) &WIFININA_config, 1, sizeof(WIFININA_config), file);
-        fclose(file);
+        uint8_t slot = order[i];
         
-        WN_LOGDEBUG(F("OK"));
-      }
+        FILE *file = fopen(slotFileName(slot), "r");
+        
+        if (!file)
+        {
+          continue;
+        }
+        
+        fseek(file, sizeof(WiFiNINA_SlotHeader), SEEK_SET);
+        uint16_t readLength = fread(data, 1, dataSize, file);
+        fclose(file);
+        
+        if ( (readLength == dataSize) && (WiFiNINA_crc32(data, dataSize) == header[slot].crc) )
+        {
+          WiFiNINA_unpackSlotData(data, WIFININA_config);
+          
+          activeSlot        = slot;
+          activeGeneration  = header[slot].generation;
+          totalDataSize     = dataSize;
+          
+          delete [] data;
+          
+          WN_LOGERROR3(F("LoadSlot="), slot, F(",Gen="), activeGeneration);
+          
+          return true;
+        }
+        
+        WN_LOGERROR1(F("Bad CRC, Slot="), slot);
+      }
+      
+      delete [] data;
+      
+      return false;
+    }
+    
+    //////////////////////////////////////////////
+    
+    bool saveSlotData()
+    {
+      WiFiNINA_SlotHeader header;
+      uint16_t  dataSize  = WiFiNINA_slotDataSize();
+      uint16_t  imageSize = sizeof(WiFiNINA_SlotHeader) + dataSize;
+      uint8_t   readBack[32];
+      bool      written   = false;
+      
+      // Always write to the inactive slot. The active one stays untouched until the new one is verified
+      uint8_t   slot      = activeSlot ^ 1;
+      
+      uint8_t* image = new uint8_t[imageSize];
+      
+      if (image == nullptr)
+      {
+        WN_LOGERROR(F("Can't alloc Slot buffer"));
+        return false;
+      }
+      
+      WiFiNINA_packSlotData(&image[sizeof(WiFiNINA_SlotHeader)], WIFININA_config);
+      WiFiNINA_initSlotHeader(header, &image[sizeof(WiFiNINA_SlotHeader)], dataSize, activeGeneration + 1);
+      memcpy(image, &header, sizeof(header));
+      
+      // Header and data go out in one write. The newer generation in the header makes this slot the active one
+      FILE *file = fopen(slotFileName(slot), "w");
+      
+      if (file)
+      {
+        written = ( fwrite(image, 1, imageSize, file) == imageSize );
+        fclose(file);
+      }
+      
+      file = fopen(slotFileName(slot), "r");
+      
+      if (file)
+      {
+        for (uint16_t offset = 0; written && (offset < imageSize); offset += sizeof(readBack))
+        {
+          uint16_t chunk = min( (uint16_t) sizeof(readBack), (uint16_t) (imageSize - offset) );
+          
+          written = ( (fread(readBack, 1, chunk, file) == chunk) && (memcmp(readBack, &image[offset], chunk) == 0) );
+        }
+        
+        fclose(file);
+      }
+      
+      delete [] image;
+      
+      if (!written)
+      {
+        WN_LOGERROR1(F("Save/Verify failed, Slot="), slot);
+        return false;
+      }
+      
+      activeSlot        = slot;
+      activeGeneration  = header.generation;
+      totalDataSize     = dataSize;
+      
+      WN_LOGERROR3(F("SaveSlot="), slot, F(",Gen="), activeGeneration);
+      
+      return true;
+    }
+    
+    //////////////////////////////////////////////
+    
+#endif    // USE_CONFIG_AB_SLOTS
+
+#if USE_PACKED_CONFIG_FILE
+
+    // New from v1.5.0
+    uint32_t  packedForcedCPFlag  = 0;
+    
+    //////////////////////////////////////////////
+    
+    // Config, Dynamic Data and forced CP flag in one read
+    bool loadPackedData()
+    {
+      WiFiNINA_PackedHeader header;
+      uint16_t  dataSize    = WiFiNINA_slotDataSize();
+      uint16_t  imageSize   = sizeof(WiFiNINA_PackedHeader) + dataSize;
+      uint16_t  readLength  = 0;
+      
+      uint8_t* image = new uint8_t[imageSize];
+      
+      if (image == nullptr)
+      {
+        WN_LOGERROR(F("Can't alloc Packed buffer"));
+        return false;
+      }
+      
+      FILE *file = fopen(CONFIG_PACKED_FILENAME, "r");
+      
+      if (file)
+      {
+        readLength = fread(image, 1, imageSize, file);
+        fclose(file);
+      }
+      
+      memcpy(&header, image, sizeof(header));
+      
+      bool valid = ( (readLength == imageSize) && (header.magic == WM_PACKED_MAGIC) && (header.length == dataSize) &&
+                     (WiFiNINA_crc32(&image[sizeof(WiFiNINA_PackedHeader)], dataSize) == header.crc) );
+      
+      if (valid)
+      {
+        WiFiNINA_unpackSlotData(&image[sizeof(WiFiNINA_PackedHeader)], WIFININA_config);
+        
+        packedForcedCPFlag  = header.forcedCPFlag;
+        totalDataSize       = dataSize;
+      }
+      
+      delete [] image;
+      
+      WN_LOGERROR1(F("LoadPackedFile "), valid ? F("OK") : F("failed"));
+      
+      return valid;
+    }
+    
+    //////////////////////////////////////////////
+    
+    // Only the forced CP flag, from the header of the packed file
+    bool loadPackedForcedCP()
+    {
+      WiFiNINA_PackedHeader header;
+      uint16_t  readLength  = 0;
+      
+      FILE *file = fopen(CONFIG_PACKED_FILENAME, "r");
+      
+      if (file)
+      {
+        readLength = fread(&header, 1, sizeof(header), file);
+        fclose(file);
+      }
+      
+      if ( (readLength != sizeof(header)) || (header.magic != WM_PACKED_MAGIC) || (header.length != WiFiNINA_slotDataSize()) )
+      {
+        return false;
+      }
+      
+      packedForcedCPFlag = header.forcedCPFlag;
+      
+      return true;
+    }
+    
+    //////////////////////////////////////////////
+    
+    // Config, Dynamic Data and forced CP flag in one write
+    bool savePackedData()
+    {
+      WiFiNINA_PackedHeader header;
+      uint16_t  dataSize  = WiFiNINA_slotDataSize();
+      uint16_t  imageSize = sizeof(WiFiNINA_PackedHeader) + dataSize;
+      bool      written   = false;
+      
+      uint8_t* image = new uint8_t[imageSize];
+      
+      if (image == nullptr)
+      {
+        WN_LOGERROR(F("Can't alloc Packed buffer"));
+        return false;
+      }
+      
+      WiFiNINA_packSlotData(&image[sizeof(WiFiNINA_PackedHeader)], WIFININA_config);
+      WiFiNINA_initPackedHeader(header, &image[sizeof(WiFiNINA_PackedHeader)], dataSize, packedForcedCPFlag);
+      memcpy(image, &header, sizeof(header));
+      
+      FILE *file = fopen(CONFIG_PACKED_FILENAME, "w");
+      
+      if (file)
+      {
+        written = ( fwrite(image, 1, imageSize, file) == imageSize );
+        fclose(file);
+      }
+      
+      delete [] image;
+      
+      if (written)
+      {
+        totalDataSize = dataSize;
+      }
+      
+      WN_LOGERROR1(F("SavePackedFile "), written ? F("OK") : F("failed"));
+      
+      return written;
+    }
+    
+    //////////////////////////////////////////////
+    
+    // Read a file of older versions, or its backup
+    bool readLegacyFile(const char* fileName, const char* backupFileName, void* data, uint16_t size)
+    {
+      FILE *file = fopen(fileName, "r");
+      
+      if (!file)
+      {
+        file = fopen(backupFileName, "r");
+        
+        if (!file)
+        {
+          return false;
+        }
+      }
+      
+      bool result = ( fread((uint8_t *) data, 1, size, file) == size );
+      fclose(file);
+      
+      return result;
+    }
+    
+    //////////////////////////////////////////////
+    
+    // Convert the config, credentials and CP files of older versions into the packed file, then remove them
+    bool migrateLegacyData()
+    {
+      if (!readLegacyFile(CONFIG_FILENAME, CONFIG_FILENAME_BACKUP, &WIFININA_config, sizeof(WIFININA_config)))
+      {
+        return false;
+      }
+      
+      int calChecksum = calcChecksum();
+      
+      if ( (calChecksum == 0) || (calChecksum != WIFININA_config.checkSum) )
+      {
+        return false;
+      }
+      
+#if USE_DYNAMIC_PARAMETERS
+      if ( !checkDynamicData() || !loadDynamicData() )
+      {
+        return false;
+      }
+#endif
+
+      if (!readLegacyFile(CONFIG_PORTAL_FILENAME, CONFIG_PORTAL_FILENAME_BACKUP, &packedForcedCPFlag, sizeof(packedForcedCPFlag)))
+      {
+        packedForcedCPFlag = 0;
+      }
+      
+      WN_LOGERROR(F("Migrate to Packed File"));
+      
+      if (savePackedData())
+      {
+        remove(CONFIG_FILENAME);
+        remove(CONFIG_FILENAME_BACKUP);
+        remove(CREDENTIALS_FILENAME);
+        remove(CREDENTIALS_FILENAME_BACKUP);
+        remove(CONFIG_PORTAL_FILENAME);
+        remove(CONFIG_PORTAL_FILENAME_BACKUP);
+      }
+      
+      return true;
+    }
+    
+    //////////////////////////////////////////////
+    
+#endif    // USE_PACKED_CONFIG_FILE
+
+    bool loadConfigData()
+    {
+#if USE_CONFIG_AB_SLOTS
+      // Config and Dynamic Data are read together from the newest valid slot
+      if (!loadSlotData())
+      {
+        memset(&WIFININA_config, 0, sizeof(WIFININA_config));
+      }
+
+      NULLTerminateConfig();
+      
+      return isWiFiConfigValid();
+#elif USE_PACKED_CONFIG_FILE
+      // Config and Dynamic Data are read together from the packed file, or the files of older versions
+      if ( !loadPackedData() && !migrateLegacyData() )
+      {
+        memset(&WIFININA_config, 0, sizeof(WIFININA_config));
+      }
+
+      NULLTerminateConfig();
+      
+      return isWiFiConfigValid();
+#else
+      WN_LOGDEBUG(F("LoadCfgFile "));
+      
+      // file existed
+      FILE *file = fopen(CONFIG_FILENAME, "r");
+      
+      if (!file)
+      {
+        WN_LOGDEBUG(F("failed"));
+
+        // Trying open redundant config file
+        file = fopen(CONFIG_FILENAME_BACKUP, "r");
+        
+        WN_LOGDEBUG(F("LoadBkUpCfgFile "));
+
+        if (!file)
+        {
+          WN_LOGDEBUG(F("failed"));
+          return false;
+        }
+      }
+     
+      fseek(file, 0, SEEK_SET);
+      fread((uint8_t *) &WIFININA_config, 1, sizeof(WIFININA_config), file);
+      fclose(file);
+
+      WN_LOGDEBUG(F("OK"));
+      
+      return isWiFiConfigValid();
+#endif
+    }
+    
+    //////////////////////////////////////////////
+
+    void saveConfigData()
+    {
+      WN_LOGDEBUG(F("SaveCfgFile "));
+
+      int calChecksum = calcChecksum();
+      WIFININA_config.checkSum = calChecksum;
+      WN_LOGDEBUG1(F("WCSum=0x"), String(calChecksum, HEX));
+      
+#if USE_CONFIG_AB_SLOTS
+      saveSlotData();
+#elif USE_PACKED_CONFIG_FILE
+      savePackedData();
+#else
+      FILE *file = fopen(CONFIG_FILENAME, "w");
+
+      if (file)
+      {
+        fseek(file, 0, SEEK_SET);
+        fwrite((uint8_t *) &WIFININA_config, 1, sizeof(WIFININA_config), file);
+        fclose(file);
+        
+        WN_LOGDEBUG(F("OK"));
+      }
       else
       {
         WN_LOGDEBUG(F("failed"));
       }
       
-#if USE_DYNAMIC_PARAMETERS      
+      WN_LOGDEBUG(F("SaveBkUpCfgFile "));
+      
+      // Trying open redundant Auth file
+      file = fopen(CONFIG_FILENAME_BACKUP, "w");
+
+      if (file)
+      {
+        fseek(file, 0, SEEK_SET);
+        fwrite((uint8_t *) &WIFININA_config, 1, sizeof(WIFININA_config), file);
+        fclose(file);
+        
+        WN_LOGDEBUG(F("OK"));
+      }
+      else
+      {
+        WN_LOGDEBUG(F("failed"));
+      }
+      
+  #if USE_DYNAMIC_PARAMETERS
       saveDynamicData();
+  #endif
 #endif
     }
     
@@ -1475,6 +2235,11 @@ class WiFiManager_NINA_Lite
     // New from v1.0.5
     void loadAndSaveDefaultConfigData()
     {
+#if USE_PACKED_CONFIG_FILE
+      // Keep the forced CP flag stored in the packed file, not its data
+      loadPackedForcedCP();
+#endif
+
       // Load Default Config Data from Sketch
       memcpy(&WIFININA_config, &defaultConfig, sizeof(WIFININA_config));
       strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
@@ -1520,7 +2285,7 @@ class WiFiManager_NINA_Lite
         WN_LOGERROR3(F("CCSum=0x"), String(calChecksum, HEX),
                    F(",RCSum=0x"), String(WIFININA_config.checkSum, HEX));
         
-#if USE_DYNAMIC_PARAMETERS        
+#if (USE_DYNAMIC_PARAMETERS && !(USE_CONFIG_AB_SLOTS || USE_PACKED_CONFIG_FILE) )
         // Load stored dynamic data from LittleFS
         dynamicDataValid = checkDynamicData();
 #endif
@@ -1531,7 +2296,7 @@ class WiFiManager_NINA_Lite
         {       
           if (dynamicDataValid)
           {
-  #if USE_DYNAMIC_PARAMETERS        
+  #if (USE_DYNAMIC_PARAMETERS && !(USE_CONFIG_AB_SLOTS || USE_PACKED_CONFIG_FILE) )
             loadDynamicData();
              
             WN_LOGERROR(F("Valid Stored Dynamic Data"));
@@ -1577,8 +2342,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS
           for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
           {
-            // Actual size of pdata is [maxlen + 1]
-            memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
+            WiFiNINA_clearMenuItem(myMenuItems[i]);
           }
 #endif
               
@@ -1591,7 +2355,8 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS
           for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
           {
-            strncpy(myMenuItems[i].pdata, WM_NO_CONFIG, myMenuItems[i].maxlen);
+            if (myMenuItems[i].type == WM_ITEM_TEXT)
+              strncpy(myMenuItems[i].pdata, WM_NO_CONFIG, myMenuItems[i].maxlen);
           }
 #endif          
         }
@@ -1601,7 +2366,7 @@ class WiFiManager_NINA_Lite
 #if USE_DYNAMIC_PARAMETERS
         for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
         {
-          WN_LOGDEBUG3(F("g:myMenuItems["), i, F("]="), myMenuItems[i].pdata );
+          WN_LOGDEBUG3(F("g:myMenuItems["), i, F("]="), WiFiNINA_menuItemToString(myMenuItems[i]) );
         }
 #endif
         
@@ -1614,18 +2379,109 @@ class WiFiManager_NINA_Lite
       }
       else if ( !isWiFiConfigValid() )
       {
-        // If SSID, PW ="blank" or NULL, stay in config mode forever until having config Data.
+        // If SSID, PW ="blank" or NULL, stay in config mode forever until having config Data.
+        return false;
+      }
+      else
+      {
+        displayConfigData(WIFININA_config);
+      }
+
+      return true;
+    }
+    
+    //////////////////////////////////////////////
+
+    // New from v1.5.0
+    // Static IP of Config Data, then of setSTAStaticIPConfig(), then the DHCP lease kept for this WiFi_Creds index.
+    // Return WM_IP_STATIC, WM_IP_LEASE or WM_IP_DHCP
+    uint8_t configIP(uint8_t index)
+    {
+#if USE_STATIC_IP_CONFIG
+      if (WiFiNINA_isIPSet(WIFININA_config.staticIP.ip))
+      {
+        WN_LOGDEBUG(F("UseCfgStatIP"));
+        WiFiNINA_configStaticIP(WIFININA_config.staticIP);
+
+        return WM_IP_STATIC;
+      }
+#endif
+
+      if (static_IP != IPAddress(0, 0, 0, 0))
+      {
+        WN_LOGDEBUG(F("UseStatIP"));
+        WiFiNINA_configStaticIP(static_IP, static_GW, static_SN, static_DNS);
+
+        return WM_IP_STATIC;
+      }
+
+#if USE_STICKY_DHCP
+      const WiFiNINA_DHCPLease& lease = WIFININA_config.dhcpLease;
+
+      if ( WiFiNINA_isIPSet(lease.ipConfig.ip) && (lease.index == index) )
+      {
+        WN_LOGDEBUG1(F("UseLease IP="), WiFiNINA_toIPAddress(lease.ipConfig.ip));
+        WiFiNINA_configStaticIP(lease.ipConfig);
+        leaseApplied = true;
+
+        return WM_IP_LEASE;
+      }
+
+      if (leaseApplied)
+      {
+        // Back to DHCP
+        WiFi.end();
+        leaseApplied = false;
+      }
+#endif
+
+      return WM_IP_DHCP;
+    }
+
+    //////////////////////////////////////////////
+
+#if USE_STICKY_DHCP
+    // New from v1.5.0
+    // After connecting with index. Keep a new DHCP lease, written by run() if changed, out of the connect path.
+    // Return false if the lease reused for index doesn't work, after dropping it
+    bool updateDHCPLease(uint8_t ipMode, uint8_t index)
+    {
+      WiFiNINA_DHCPLease& lease = WIFININA_config.dhcpLease;
+
+      if (ipMode == WM_IP_LEASE)
+      {
+        // Applied by configIP() only for its own index
+        if ( (lease.index != index) || WiFiNINA_verifyDHCPLease(lease) )
+          return true;
+
+        WN_LOGDEBUG(F("DropLease"));
+
+        memset(&lease, 0, sizeof(lease));
+        leaseChanged = true;
+
         return false;
       }
-      else
+
+      if (ipMode == WM_IP_DHCP)
       {
-        displayConfigData(WIFININA_config);
+        WiFiNINA_DHCPLease newLease;
+
+        WiFiNINA_readDHCPLease(newLease, index);
+
+        if ( WiFiNINA_isIPSet(newLease.ipConfig.ip) && memcmp(&newLease, &lease, sizeof(lease)) )
+        {
+          WN_LOGDEBUG1(F("SaveLease IP="), WiFi.localIP());
+
+          lease         = newLease;
+          leaseChanged  = true;
+        }
       }
 
       return true;
     }
-    
+
     //////////////////////////////////////////////
+#endif
 
     // New connection logic from v1.2.0
     bool connectMultiWiFi(int retry_time)
@@ -1639,12 +2495,6 @@ class WiFiManager_NINA_Lite
 
       WN_LOGDEBUG(F("ConMultiWifi"));
       
-      if (static_IP != IPAddress(0, 0, 0, 0))
-      {
-        WN_LOGDEBUG(F("UseStatIP"));
-        WiFi.config(static_IP);
-      }
-      
       if (lastConnectedIndex != 255)
       {
         //  Successive connection, index = ??
@@ -1681,6 +2531,11 @@ class WiFiManager_NINA_Lite
         }
       } 
          
+#if USE_STICKY_DHCP
+      int     retries = retry_time;
+      uint8_t ipMode  = WM_IP_DHCP;
+#endif
+
       WN_LOGERROR3(F("con2WF:SSID="), WIFININA_config.WiFi_Creds[index].wifi_ssid,
                    F(",PW="), WIFININA_config.WiFi_Creds[index].wifi_pw);
       
@@ -1688,6 +2543,13 @@ class WiFiManager_NINA_Lite
       
       while ( !wifi_connected && (numIndexTried++ < NUM_WIFI_CREDENTIALS) )
       {         
+        // New from v1.5.0. IP config of the index tried, not of the first one
+#if USE_STICKY_DHCP
+        ipMode = configIP(index);
+#else
+        configIP(index);
+#endif
+
         while ( 0 < retry_time )
         {      
           WN_LOGDEBUG1(F("Remaining retry_time="), retry_time);
@@ -1734,9 +2596,36 @@ class WiFiManager_NINA_Lite
         }
       }
 
+#if USE_STICKY_DHCP
+      if ( wifi_connected && !updateDHCPLease(ipMode, index) )
+      {
+        // Same SSID again, now with DHCP, as the lease of this index is dropped
+        WiFi.end();
+        leaseApplied    = false;
+        wifi_connected  = false;
+
+        configIP(index);
+
+        while ( !wifi_connected && (0 < retries--) )
+        {
+          if (WiFi.begin(WIFININA_config.WiFi_Creds[index].wifi_ssid, WIFININA_config.WiFi_Creds[index].wifi_pw) == WL_CONNECTED)
+            wifi_connected = true;
+          else
+            delay(sleep_time);
+        }
+
+        if (wifi_connected)
+          updateDHCPLease(WM_IP_DHCP, index);
+      }
+#endif
+
       if (wifi_connected)
       {
         WN_LOGERROR(F("con2WF:OK"));
+
+        // New from v1.5.0
+        if (wifiPowerSave)
+          WiFi.lowPowerMode();
         
         WN_LOGERROR1(F("IP="), WiFi.localIP() );
         
@@ -1775,100 +2664,388 @@ class WiFiManager_NINA_Lite
       if (_CustomsHeadElement)
         root_html_template += _CustomsHeadElement;
   #endif          
+
+#if SCAN_WIFI_NETWORKS
+      // New from v1.5.0. One shared, empty SSID list, filled by the page from /scan. The page doesn't depend on the
+      // number of SSIDs found, and the SSIDs are never parsed as HTML
+      pitem = String(WIFININA_HTML_HEAD_END);
+
+#if MANUAL_SSID_INPUT_ALLOWED
+      pitem.replace("[[input_id]]",  "<input id='id' list='SSIDs'>"  + String(WIFININA_DATALIST_START) + "'SSIDs'>" + WIFININA_DATALIST_END);
+      pitem.replace("[[input_id1]]", "<input id='id1' list='SSIDs'>");
+#else
+      pitem.replace("[[input_id]]",  "<select id='id'>"  + String(WIFININA_SELECT_END));
+      pitem.replace("[[input_id1]]", "<select id='id1'>" + String(WIFININA_SELECT_END));
+#endif
+
+      root_html_template += pitem + WIFININA_FLDSET_START;
+
+#else
+
+      pitem = String(WIFININA_HTML_HEAD_END);
+      pitem.replace("[[input_id]]",  WIFININA_HTML_INPUT_ID);
+      pitem.replace("[[input_id1]]", WIFININA_HTML_INPUT_ID1);
+      root_html_template += pitem + WIFININA_FLDSET_START;
+
+#endif    // SCAN_WIFI_NETWORKS
+   
+#if USE_DYNAMIC_PARAMETERS      
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        pitem = String(WIFININA_HTML_PARAM);
+
+        pitem.replace("{b}", myMenuItems[i].displayName);
+        pitem.replace("{v}", myMenuItems[i].id);
+        pitem.replace("{i}", myMenuItems[i].id);
+        
+        root_html_template += pitem;
+      }
+#endif
+      
+#if USE_STATIC_IP_CONFIG
+      root_html_template += String(WIFININA_FLDSET_END) + WIFININA_FLDSET_START + WIFININA_HTML_STATIC_IP;
+#endif
+
+      root_html_template += String(WIFININA_FLDSET_END) + WIFININA_HTML_BUTTON + WIFININA_HTML_SCRIPT + WIFININA_HTML_END;
       
+      return;     
+    }
+
+#if USE_PAGE_STREAMING
+    // New from v1.5.0
+    // The page of createHTML(), with the values replaced by handleRequest(), written to page
+    void writePage(WiFiNINA_PageWriter& page)
+    {
+      auto value = [this](WiFiNINA_PageWriter& out, const char* token, size_t tokenLen)
+      {
+        return writePageValue(out, token, tokenLen);
+      };
+
+      if ( RFC952_hostname[0] != 0 )
+      {
+        page.setName("RP2040_WM_NINA_Lite", RFC952_hostname);
+      }
+      else if ( WIFININA_config.board_name[0] != 0 )
+      {
+        page.setName("RP2040_WM_NINA_Lite", WIFININA_config.board_name);
+      }
+
+      page.expand(WIFININA_HTML_HEAD_START, value);
+
+  #if USING_CUSTOMS_STYLE
+      // Using Customs style when not NULL
+      page.expand(WIFININA_HTML_HEAD_CUSTOMS_STYLE ? WIFININA_HTML_HEAD_CUSTOMS_STYLE : WIFININA_HTML_HEAD_STYLE, value);
+  #else
+      page.expand(WIFININA_HTML_HEAD_STYLE, value);
+  #endif
+
+  #if USING_CUSTOMS_HEAD_ELEMENT
+      if (_CustomsHeadElement)
+        page.expand(_CustomsHeadElement, value);
+  #endif
+
+      page.expand(WIFININA_HTML_HEAD_END, value);
+      page.expand(WIFININA_FLDSET_START, value);
+
+#if USE_DYNAMIC_PARAMETERS
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        page.expand(WIFININA_HTML_PARAM, [this, i](WiFiNINA_PageWriter& out, const char* token, size_t tokenLen)
+        {
+          if (token[0] == '{')
+          {
+            // {b} is the label, {v} and {i} the id
+            if ( (token[1] != 'b') && (token[1] != 'v') && (token[1] != 'i') )
+              return false;
+
+            out.print( (token[1] == 'b') ? myMenuItems[i].displayName : myMenuItems[i].id );
+
+            return true;
+          }
+
+          if (!WiFiNINA_isPageKey(token, tokenLen, "{v}"))
+            return writePageValue(out, token, tokenLen);
+
+          // [[{v}]] is [[id]], then its value
+          char key[MAX_ID_LEN + 5];
+
+          snprintf(key, sizeof(key), "[[%s]]", myMenuItems[i].id);
+
+          if (!writePageValue(out, key, strlen(key)))
+            out.print(key);
+
+          return true;
+        });
+      }
+#endif
+
+#if USE_STATIC_IP_CONFIG
+      page.expand(WIFININA_FLDSET_END, value);
+      page.expand(WIFININA_FLDSET_START, value);
+      page.expand(WIFININA_HTML_STATIC_IP, value);
+#endif
+
+      page.expand(WIFININA_FLDSET_END, value);
+      page.expand(WIFININA_HTML_BUTTON, value);
+      page.expand(WIFININA_HTML_SCRIPT, value);
+      page.expand(WIFININA_HTML_END, value);
+    }
+
+    //////////////////////////////////////////////
+
+    // Write the value of token, [[key]] of the page. Return false if unknown
+    bool writePageValue(WiFiNINA_PageWriter& page, const char* token, size_t tokenLen)
+    {
 #if SCAN_WIFI_NETWORKS
-      WN_LOGDEBUG1(WiFiNetworksFound, F(" SSIDs found, generating HTML now"));
-      // Replace HTML <input...> with <select...>, based on WiFi network scan in startConfigurationMode()
+      // Shared, empty SSID list, filled by the page from /scan
+  #if MANUAL_SSID_INPUT_ALLOWED
+      if (WiFiNINA_isPageKey(token, tokenLen, "input_id"))
+      {
+        page.print("<input id='id' list='SSIDs'>");
+        page.print(WIFININA_DATALIST_START);
+        page.print("'SSIDs'>");
+        page.print(WIFININA_DATALIST_END);
 
-      ListOfSSIDs = "";
+        return true;
+      }
 
-      for (int i = 0, list_items = 0; (i < WiFiNetworksFound) && (list_items < MAX_SSID_IN_LIST); i++)
+      if (WiFiNINA_isPageKey(token, tokenLen, "input_id1"))
       {
-        if (indices[i] == -1) 
-          continue; 		// skip duplicates and those that are below the required quality
-          
-        ListOfSSIDs += WIFININA_OPTION_START + String(WiFi.SSID(indices[i])) + WIFININA_OPTION_END;	
-        list_items++;		// Count number of suitable, distinct SSIDs to be included in list
+        page.print("<input id='id1' list='SSIDs'>");
+
+        return true;
+      }
+  #else
+      if ( WiFiNINA_isPageKey(token, tokenLen, "input_id") || WiFiNINA_isPageKey(token, tokenLen, "input_id1") )
+      {
+        page.print( (tokenLen == 12) ? "<select id='id'>" : "<select id='id1'>" );
+        page.print(WIFININA_SELECT_END);
+
+        return true;
       }
+  #endif
+#else
+      if ( WiFiNINA_isPageKey(token, tokenLen, "input_id") || WiFiNINA_isPageKey(token, tokenLen, "input_id1") )
+      {
+        page.expand( (tokenLen == 12) ? WIFININA_HTML_INPUT_ID : WIFININA_HTML_INPUT_ID1,
+                     [this](WiFiNINA_PageWriter& out, const char* key, size_t keyLen) { return writePageValue(out, key, keyLen); } );
 
-      WN_LOGDEBUG(ListOfSSIDs);
+        return true;
+      }
+#endif    // SCAN_WIFI_NETWORKS
 
-      if (ListOfSSIDs == "")		// No SSID found or none was good enough
-        ListOfSSIDs = WIFININA_OPTION_START + String(WIFININA_NO_NETWORKS_FOUND) + WIFININA_OPTION_END;
 
-      pitem = String(WIFININA_HTML_HEAD_END);
+      static const char* const credKeys[] = { "id", "pw", "id1", "pw1" };
 
-#if MANUAL_SSID_INPUT_ALLOWED
-      pitem.replace("[[input_id]]",  "<input id='id' list='SSIDs'>"  + String(WIFININA_DATALIST_START) + "'SSIDs'>" + ListOfSSIDs + WIFININA_DATALIST_END);
-      pitem.replace("[[input_id1]]", "<input id='id1' list='SSIDs'>" + String(WIFININA_DATALIST_START) + "'SSIDs'>" + ListOfSSIDs + WIFININA_DATALIST_END);
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        if (WiFiNINA_isPageKey(token, tokenLen, credKeys[i]))
+        {
+          if (hadConfigData)
+            page.print( (i % 2) ? WIFININA_config.WiFi_Creds[i / 2].wifi_pw : WIFININA_config.WiFi_Creds[i / 2].wifi_ssid );
+
+          return true;
+        }
+      }
+
+      if (WiFiNINA_isPageKey(token, tokenLen, "nm"))
+      {
+        if (hadConfigData)
+          page.print(WIFININA_config.board_name);
+
+        return true;
+      }
+
+#if USE_STATIC_IP_CONFIG
+      static const char* const ipKeys[] = { "ip", "gw", "sn", "dns" };
+
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        if (WiFiNINA_isPageKey(token, tokenLen, ipKeys[i]))
+        {
+          if (hadConfigData)
+            page.print(WiFiNINA_staticIPFieldToString(WiFiNINA_staticIPField(WIFININA_config.staticIP, WM_KEY_IP + i)));
+
+          return true;
+        }
+      }
+#endif
+
+#if USE_DYNAMIC_PARAMETERS
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        if (WiFiNINA_isPageKey(token, tokenLen, myMenuItems[i].id))
+        {
+          page.print(WiFiNINA_menuItemToString(myMenuItems[i]));
+
+          return true;
+        }
+      }
+#endif
+
+      return false;
+    }
+
+    //////////////////////////////////////////////
+
+    // Send the page with its Content-Length, then the page itself, without holding it in a String
+    void sendPage()
+    {
+      size_t length;
+
+      {
+        WiFiNINA_PageWriter counter;
+
+        writePage(counter);
+        length = counter.length();
+      }
+
+      WN_LOGDEBUG1(F("h:HTML page size:"), length);
+
+      server->setContentLength(length);
+      server->send(200, "text/html", "");
+
+      WiFiClient          client = server->client();
+      WiFiNINA_PageWriter page(&client);
+
+      writePage(page);
+
+      if (!page.flush())
+      {
+        WN_LOGDEBUG(F("h:PageNotSent"));
+      }
+    }
+#endif    // USE_PAGE_STREAMING
+       
+    //////////////////////////////////////////////
+
+    void serverSendHeaders()
+    {
+      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_CACHE_CONTROL:"), WM_HTTP_CACHE_CONTROL, "=", WM_HTTP_NO_STORE);
+      server->sendHeader(WM_HTTP_CACHE_CONTROL, WM_HTTP_NO_STORE);
+      
+#if USING_CORS_FEATURE
+      // New from v1.1.0, for configure CORS Header, default to WM_HTTP_CORS_ALLOW_ALL = "*"
+      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_CORS:"), WM_HTTP_CORS, " : ", _CORS_Header);
+      server->sendHeader(WM_HTTP_CORS, _CORS_Header);
+#endif
+     
+      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_PRAGMA:"), WM_HTTP_PRAGMA, " : ", WM_HTTP_NO_CACHE);
+      server->sendHeader(WM_HTTP_PRAGMA, WM_HTTP_NO_CACHE);
+      
+      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_EXPIRES:"), WM_HTTP_EXPIRES, " : ", "-1");
+      server->sendHeader(WM_HTTP_EXPIRES, "-1");
+    }
+       
+    //////////////////////////////////////////////
+
+    // New from v1.5.0
+    // The next Config Data from Config Portal starts again with no item
+    void clearItemsUpdated()
+    {
+      number_items_Updated  = 0;
+      id_Updated            = false;
+      pw_Updated            = false;
+      id1_Updated           = false;
+      pw1_Updated           = false;
+      nm_Updated            = false;
+
+#if USE_STATIC_IP_CONFIG
+      ip_Updated            = 0;
+#endif
+
+#if USE_DYNAMIC_PARAMETERS
+      if (menuItemUpdated)
+      {
+        for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+        {
+          menuItemUpdated[i] = false;
+        }
+      }
+#endif
+    }
+
+    //////////////////////////////////////////////
+
+    // Config Data is saved, from Config Portal
+    void configSaved()
+    {
+      clearItemsUpdated();
+
+#if USE_LIVE_RECONFIG
+      // New from v1.5.0. Applied by run(), without blocking here
+      reconfigureTime     = millis();
+      reconfigurePending  = true;
+#else
+      WN_LOGDEBUG(F("h:Rst"));
+
+      // Delay then reset the board after save data
+      delay(1000);
+      resetFunc();  //call reset
+#endif
+    }
+
+#if USE_RUN_SERVICES
+    // New from v1.5.0
+    void runServices()
+    {
+      for (uint8_t i = 0; i < numServices; i++)
+      {
+        services[i]->runService(wifi_connected, WM_SERVICE_TIME_SLICE);
+      }
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_LIVE_RECONFIG
+    // New from v1.5.0
+    // Stop Config Portal, then connect with the saved Config Data, as begin() does after reset. Reset if no WiFi
+    void reconfigure()
+    {
+      reconfigurePending = false;
+
+#if USE_CAPTIVE_PORTAL_DNS
+      if (dnsServer)
+      {
+        dnsServer->stop();
+        delete dnsServer;
+        dnsServer = NULL;
+      }
+#endif
+
+      // Stops the AP, and drops its IP config and sockets
+      WiFi.end();
+
+      // Its handlers are added again by the next startConfigurationMode()
+      if (server)
+      {
+        delete server;
+        server = NULL;
+      }
 
-#else
-      pitem.replace("[[input_id]]",  "<select id='id'>"  + ListOfSSIDs + WIFININA_SELECT_END);
-      pitem.replace("[[input_id1]]", "<select id='id1'>" + ListOfSSIDs + WIFININA_SELECT_END);
+#if USE_STICKY_DHCP
+      leaseApplied    = false;
 #endif
 
-      root_html_template += pitem + WIFININA_FLDSET_START;
-
-#else
-
-      pitem = String(WIFININA_HTML_HEAD_END);
-      pitem.replace("[[input_id]]",  WIFININA_HTML_INPUT_ID);
-      pitem.replace("[[input_id1]]", WIFININA_HTML_INPUT_ID1);
-      root_html_template += pitem + WIFININA_FLDSET_START;
+      wifi_connected  = false;
 
-#endif    // SCAN_WIFI_NETWORKS
-   
-#if USE_DYNAMIC_PARAMETERS      
-      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      if (connectMultiWiFi(RETRY_TIMES_CONNECT_WIFI))
       {
-        pitem = String(WIFININA_HTML_PARAM);
+        WN_LOGERROR(F("r:ReconfWOK"));
 
-        pitem.replace("{b}", myMenuItems[i].displayName);
-        pitem.replace("{v}", myMenuItems[i].id);
-        pitem.replace("{i}", myMenuItems[i].id);
-        
-        root_html_template += pitem;
+        hadConfigData       = true;
+        configuration_mode  = false;
       }
-#endif
-      
-      root_html_template += String(WIFININA_FLDSET_END) + WIFININA_HTML_BUTTON + WIFININA_HTML_SCRIPT;     
-
-#if USE_DYNAMIC_PARAMETERS      
-      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      else
       {
-        pitem = String(WIFININA_HTML_SCRIPT_ITEM);
-        
-        pitem.replace("{d}", myMenuItems[i].id);
-        
-        root_html_template += pitem;
+        WN_LOGERROR(F("r:ReconfNoW.Rst"));
+
+        resetFunc();  //call reset
       }
-#endif
-      
-      root_html_template += String(WIFININA_HTML_SCRIPT_END) + WIFININA_HTML_END;
-      
-      return;     
     }
-       
-    //////////////////////////////////////////////
-
-    void serverSendHeaders()
-    {
-      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_CACHE_CONTROL:"), WM_HTTP_CACHE_CONTROL, "=", WM_HTTP_NO_STORE);
-      server->sendHeader(WM_HTTP_CACHE_CONTROL, WM_HTTP_NO_STORE);
-      
-#if USING_CORS_FEATURE
-      // New from v1.1.0, for configure CORS Header, default to WM_HTTP_CORS_ALLOW_ALL = "*"
-      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_CORS:"), WM_HTTP_CORS, " : ", _CORS_Header);
-      server->sendHeader(WM_HTTP_CORS, _CORS_Header);
 #endif
-     
-      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_PRAGMA:"), WM_HTTP_PRAGMA, " : ", WM_HTTP_NO_CACHE);
-      server->sendHeader(WM_HTTP_PRAGMA, WM_HTTP_NO_CACHE);
-      
-      WN_LOGDEBUG3(F("serverSendHeaders:WM_HTTP_EXPIRES:"), WM_HTTP_EXPIRES, " : ", "-1");
-      server->sendHeader(WM_HTTP_EXPIRES, "-1");
-    }
-       
+
     //////////////////////////////////////////////
 
     void handleRequest()
@@ -1878,14 +3055,20 @@ class WiFiManager_NINA_Lite
         String key    = server->arg("key");
         String value  = server->arg("value");
 
-        static int number_items_Updated = 0;
-
         if (key == "" && value == "")
         {
           // New from v1.1.0         
           serverSendHeaders();        
           //////
           
+#if USE_PAGE_STREAMING
+          // Reset configTimeout to stay here until finished.
+          configTimeout = 0;
+
+          sendPage();
+
+          return;
+#else
           String result;
           createHTML(result);
 
@@ -1919,12 +3102,16 @@ class WiFiManager_NINA_Lite
             result.replace("[[pw1]]", "");
             result.replace("[[nm]]",  "");
           }
+
+#if USE_STATIC_IP_CONFIG
+          WiFiNINA_replaceStaticIP(result, hadConfigData ? &WIFININA_config.staticIP : NULL);
+#endif
           
 #if USE_DYNAMIC_PARAMETERS          
           for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
           {
             String toChange = String("[[") + myMenuItems[i].id + "]]";
-            result.replace(toChange, myMenuItems[i].pdata);
+            result.replace(toChange, WiFiNINA_menuItemToString(myMenuItems[i]));
           }
 #endif
 
@@ -1934,8 +3121,19 @@ class WiFiManager_NINA_Lite
           
           server->send(200, "text/html", result);
 
+          return;
+#endif
+        }
+
+#if USE_LIVE_RECONFIG
+        // Saved, and not yet applied by reconfigure()
+        if (reconfigurePending)
+        {
+          server->send(200, "text/html", "OK");
+
           return;
         }
+#endif
 
         if (number_items_Updated == 0)
         {
@@ -1964,15 +3162,26 @@ class WiFiManager_NINA_Lite
             WN_LOGERROR(F("h: Error can't alloc memory for menuItemUpdated" ));
           }
         }  
+
+        if (!menuItemIndex)
+        {
+          // Don't need to free
+          menuItemIndex = new uint16_t[NUM_MENU_ITEMS];
+
+          if (menuItemIndex)
+          {
+            WiFiNINA_buildMenuItemIndex(myMenuItems, menuItemIndex, NUM_MENU_ITEMS);
+          }
+          else
+          {
+            WN_LOGERROR(F("h: Error can't alloc memory for menuItemIndex" ));
+          }
+        }
 #endif
 
-        static bool id_Updated  = false;
-        static bool pw_Updated  = false;
-        static bool id1_Updated = false;
-        static bool pw1_Updated = false;
-        static bool nm_Updated  = false;
+        uint8_t builtinKey = WiFiNINA_builtinKey(key.c_str());
           
-        if (!id_Updated && (key == String("id")))
+        if (!id_Updated && (builtinKey == WM_KEY_ID))
         {   
           WN_LOGDEBUG(F("h:repl id"));
           id_Updated = true;
@@ -1983,7 +3192,7 @@ class WiFiManager_NINA_Lite
           else
             strncpy(WIFININA_config.WiFi_Creds[0].wifi_ssid, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[0].wifi_ssid) - 1);
         }
-        else if (!pw_Updated && (key == String("pw")))
+        else if (!pw_Updated && (builtinKey == WM_KEY_PW))
         {    
           WN_LOGDEBUG(F("h:repl pw"));
           pw_Updated = true;
@@ -1994,7 +3203,7 @@ class WiFiManager_NINA_Lite
           else
             strncpy(WIFININA_config.WiFi_Creds[0].wifi_pw, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[0].wifi_pw) - 1);
         }
-        else if (!id1_Updated && (key == String("id1")))
+        else if (!id1_Updated && (builtinKey == WM_KEY_ID1))
         {   
           WN_LOGDEBUG(F("h:repl id1"));
           id1_Updated = true;
@@ -2005,7 +3214,7 @@ class WiFiManager_NINA_Lite
           else
             strncpy(WIFININA_config.WiFi_Creds[1].wifi_ssid, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[1].wifi_ssid) - 1);
         }
-        else if (!pw1_Updated && (key == String("pw1")))
+        else if (!pw1_Updated && (builtinKey == WM_KEY_PW1))
         {    
           WN_LOGDEBUG(F("h:repl pw1"));
           pw1_Updated = true;
@@ -2016,7 +3225,7 @@ class WiFiManager_NINA_Lite
           else
             strncpy(WIFININA_config.WiFi_Creds[1].wifi_pw, value.c_str(), sizeof(WIFININA_config.WiFi_Creds[1].wifi_pw) - 1);
         }
-        else if (!nm_Updated && (key == String("nm")))
+        else if (!nm_Updated && (builtinKey == WM_KEY_NM))
         {
           WN_LOGDEBUG(F("h:repl nm"));
           nm_Updated = true;
@@ -2027,30 +3236,41 @@ class WiFiManager_NINA_Lite
           else
             strncpy(WIFININA_config.board_name, value.c_str(), sizeof(WIFININA_config.board_name) - 1);
         }
+#if USE_STATIC_IP_CONFIG
+        else if ( WiFiNINA_staticIPField(WIFININA_config.staticIP, builtinKey)
+                  && !(ip_Updated & (1 << (builtinKey - WM_KEY_IP))) )
+        {
+          WN_LOGDEBUG1(F("h:repl "), key);
+          ip_Updated |= (1 << (builtinKey - WM_KEY_IP));
+
+          number_items_Updated++;
+
+          // An invalid address keeps the current one
+          if (!WiFiNINA_setStaticIPField(WiFiNINA_staticIPField(WIFININA_config.staticIP, builtinKey), value.c_str()))
+          {
+            WN_LOGERROR3(F("h:Invalid "), key, F("="), value);
+          }
+        }
+#endif
 
         
 #if USE_DYNAMIC_PARAMETERS
         else
         {
-          for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
-          {           
-            if ( !menuItemUpdated[i] && (key == myMenuItems[i].id) )
-            {
-              WN_LOGDEBUG3(F("h:"), myMenuItems[i].id, F("="), value.c_str() );
+          int i = menuItemIndex ? WiFiNINA_findMenuItem(myMenuItems, menuItemIndex, NUM_MENU_ITEMS, key.c_str()) : -1;
+
+          if ( (i >= 0) && menuItemUpdated && !menuItemUpdated[i] )
+          {
+            WN_LOGDEBUG3(F("h:"), myMenuItems[i].id, F("="), value.c_str() );
               
-              menuItemUpdated[i] = true;
+            menuItemUpdated[i] = true;
               
-              number_items_Updated++;
+            number_items_Updated++;
 
-              // Actual size of pdata is [maxlen + 1]
-              memset(myMenuItems[i].pdata, 0, myMenuItems[i].maxlen + 1);
-
-              if ((int) strlen(value.c_str()) < myMenuItems[i].maxlen)
-                strcpy(myMenuItems[i].pdata, value.c_str());
-              else
-                strncpy(myMenuItems[i].pdata, value.c_str(), myMenuItems[i].maxlen);
-                
-              break;  
+            // Typed items are validated here. An invalid value keeps the current one
+            if (!WiFiNINA_setMenuItem(myMenuItems[i], value.c_str()))
+            {
+              WN_LOGERROR3(F("h:Invalid "), myMenuItems[i].id, F("="), value);
             }
           }
         }  
@@ -2075,18 +3295,177 @@ class WiFiManager_NINA_Lite
           if (isForcedConfigPortal)
             clearForcedCP();
 
-          WN_LOGDEBUG(F("h:Rst"));
-
-          // TO DO : what command to reset
-          // Delay then reset the board after save data
-          delay(1000);
-          resetFunc();  //call reset
+          configSaved();
         }
       }   // if (server)
     }
     
     //////////////////////////////////////////////
 
+    // New from v1.5.0
+    // Gzipped style and script of Config Portal page. Their URLs change with their content, so they can be cached for good
+    void handleAsset(const char* contentType, const uint8_t* data, uint16_t length)
+    {
+      if (server)
+      {
+        server->sendHeader("Content-Encoding", "gzip");
+        server->sendHeader("Cache-Control", "max-age=31536000");
+        server->send_P(200, contentType, (PGM_P) data, length);
+      }
+    }
+
+    //////////////////////////////////////////////
+
+#if SCAN_WIFI_NETWORKS
+    // New from v1.5.0
+    // GET /scan : SSIDs found by the scan in startConfigurationMode(), strongest first, one per line.
+    // Built once, then reused by all page loads
+    void handleScan()
+    {
+      if (server)
+      {
+        if (ListOfSSIDs == "")
+        {
+          for (int i = 0, list_items = 0; indices && (i < WiFiNetworksFound) && (list_items < MAX_SSID_IN_LIST); i++)
+          {
+            if (indices[i] == -1)
+              continue;     // skip duplicates and those that are below the required quality
+
+            ListOfSSIDs += String(WiFi.SSID(indices[i])) + "\n";
+            list_items++;   // Count number of suitable, distinct SSIDs to be included in list
+          }
+
+          WN_LOGDEBUG(ListOfSSIDs);
+
+          if (ListOfSSIDs == "")    // No SSID found or none was good enough
+            ListOfSSIDs = String(WIFININA_NO_NETWORKS_FOUND) + "\n";
+        }
+
+        server->send(200, "text/plain", ListOfSSIDs);
+      }
+    }
+
+    //////////////////////////////////////////////
+#endif
+
+#if USE_JSON_CONFIG_API
+    // New from v1.5.0
+    // GET /config.json exports, POST /config.json imports and saves Config Data and Dynamic Parameters in one request
+    void handleConfigJson()
+    {
+      if (server)
+      {
+        // Reset configTimeout to stay here until finished.
+        configTimeout = 0;
+
+        serverSendHeaders();
+
+        if (server->method() != HTTP_POST)
+        {
+          server->send(200, "application/json", WiFiNINA_configToJson(WIFININA_config));
+
+          return;
+        }
+
+#if USE_LIVE_RECONFIG
+        // Saved, and not yet applied by reconfigure(). Not changed meanwhile
+        if (reconfigurePending)
+        {
+          server->send(409, "application/json", "{\"error\":\"pending\",\"key\":\"\"}");
+
+          return;
+        }
+#endif
+
+        String json = server->arg("plain");
+        char   errorKey[MAX_ID_LEN + 2];
+
+        // Validate all, before changing anything
+        if (!WiFiNINA_parseConfigJson(json.c_str(), json.length(), WIFININA_config, false, errorKey))
+        {
+          WN_LOGERROR1(F("h:Invalid JSON, key="), errorKey);
+
+          server->send(400, "application/json", WiFiNINA_jsonError(errorKey));
+
+          return;
+        }
+
+        if (!hadConfigData)
+        {
+          // Don't keep invalid data for the keys not in the request
+          memset(&WIFININA_config, 0, sizeof(WIFININA_config));
+        }
+
+        WiFiNINA_parseConfigJson(json.c_str(), json.length(), WIFININA_config, true, errorKey);
+        strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
+
+        WN_LOGDEBUG(F("h:UpdJSON"));
+
+        saveConfigData();
+
+        server->send(200, "application/json", "{\"saved\":true}");
+
+        // Done with CP, Clear CP Flag here if forced
+        if (isForcedConfigPortal)
+          clearForcedCP();
+
+        configSaved();
+      }
+    }
+#endif
+    
+    //////////////////////////////////////////////
+
+#if USE_SERIAL_CONFIG
+    // New from v1.5.0
+    // READ returns, WRITE saves the whole Config image : Config Data, Dynamic Parameters and forced CP flag.
+    // RESET makes the written data effective
+    void handleSerialConfig()
+    {
+      uint8_t request = serialConfig.poll();
+
+      if (request == WM_SC_READ)
+      {
+        uint8_t forcedCP = isForcedConfigPortal ? ( persForcedConfigPortal ? WM_SC_CP_PERSISTENT : WM_SC_CP_ONCE ) : WM_SC_CP_NONE;
+
+        serialConfig.sendImage(WIFININA_config, forcedCP);
+      }
+      else if (request == WM_SC_WRITE)
+      {
+        uint8_t forcedCP;
+        uint8_t status = serialConfig.getImage(WIFININA_config, forcedCP);
+
+        if (status == WM_SC_OK)
+        {
+          NULLTerminateConfig();
+          strcpy(WIFININA_config.header, WIFININA_BOARD_TYPE);
+
+          WN_LOGDEBUG(F("SC:Upd"));
+
+          saveConfigData();
+
+          if (forcedCP == WM_SC_CP_NONE)
+            clearForcedCP();
+          else
+            setForcedCP(forcedCP == WM_SC_CP_PERSISTENT);
+        }
+
+        serialConfig.sendStatus(status);
+      }
+      else if (request == WM_SC_RESET)
+      {
+        serialConfig.sendStatus(WM_SC_OK);
+
+        WN_LOGDEBUG(F("SC:Rst"));
+
+        delay(100);
+        resetFunc();  //call reset
+      }
+    }
+#endif
+    
+    //////////////////////////////////////////////
+
 #ifndef CONFIG_TIMEOUT
   #warning Default CONFIG_TIMEOUT = 60s
   #define CONFIG_TIMEOUT			60000L
@@ -2098,6 +3477,7 @@ class WiFiManager_NINA_Lite
       configTimeout = 0;  // To allow user input in CP
 
       WiFiNetworksFound = scanWifiNetworks(&indices);
+      ListOfSSIDs = "";
 #endif
     
       WiFi.config(portal_apIP);
@@ -2135,7 +3515,7 @@ class WiFiManager_NINA_Lite
 
       if (!server)
       {
-        server = new WiFiWebServer;
+        server = new WiFiNINA_WebServer;
       }
 
       //See https://stackoverflow.com/questions/39803135/c-unresolved-overloaded-function-type?rq=1
@@ -2143,9 +3523,40 @@ class WiFiManager_NINA_Lite
       if (server)
       {
         server->on("/", [this](){ handleRequest(); });
+
+        // New from v1.5.0
+        server->on(WIFININA_CSS_PATH, [this](){ handleAsset(WIFININA_CSS_TYPE, WIFININA_CSS_GZ, sizeof(WIFININA_CSS_GZ)); });
+        server->on(WIFININA_JS_PATH,  [this](){ handleAsset(WIFININA_JS_TYPE,  WIFININA_JS_GZ,  sizeof(WIFININA_JS_GZ)); });
+
+#if SCAN_WIFI_NETWORKS
+        server->on("/scan", [this](){ handleScan(); });
+#endif
+
+#if USE_JSON_CONFIG_API
+        server->on("/config.json", [this](){ handleConfigJson(); });
+#endif
+
+#if USE_CAPTIVE_PORTAL_DNS
+        // New from v1.5.0. OS connectivity checks and any other page are redirected to Config Portal
+        server->onNotFound([this](){ WiFiNINA_redirectToPortal(server, portal_apIP); });
+#endif
+
         server->begin();
       }
 
+#if USE_CAPTIVE_PORTAL_DNS
+      if (!dnsServer)
+      {
+        // Every name resolves to portal_apIP while in Config Portal
+        dnsServer = new WiFiNINA_DNSServer;
+
+        if (dnsServer)
+        {
+          dnsServer->start(portal_apIP);
+        }
+      }
+#endif
+
       // If there is no saved config Data, stay in config mode forever until having config Data.
       // or SSID, PW, Server,Token ="nothing"
       if (hadConfigData)
@@ -2335,4 +3746,79 @@ class WiFiManager_NINA_Lite
 };
 
 
+//////////////////////////////////////////////
+
+#ifndef WM_SPOOL_FILENAME
+  #define WM_SPOOL_FILENAME               ("/fs/wm_spool.dat")
+#endif
+
+// New from v1.5.0
+// WiFiNINA_SpoolStorage in a LittleFS file, for WiFiNINA_MQTT_Spool. LittleFS spreads the writes over the flash
+class WiFiNINA_FileSpool : public WiFiNINA_SpoolStorage
+{
+  public:
+
+    WiFiNINA_FileSpool(const char* fileName = WM_SPOOL_FILENAME) : fileName(fileName)
+    {
+    }
+
+    bool append(const uint8_t* data, uint16_t length)
+    {
+      bool written = false;
+
+      FILE *file = fopen(fileName, "a");
+
+      if (file)
+      {
+        written = ( fwrite(data, 1, length, file) == length );
+        fclose(file);
+      }
+
+      return written;
+    }
+
+    uint16_t read(uint32_t offset, uint8_t* data, uint16_t length)
+    {
+      uint16_t count = 0;
+
+      FILE *file = fopen(fileName, "r");
+
+      if (file)
+      {
+        if (fseek(file, offset, SEEK_SET) == 0)
+          count = fread(data, 1, length, file);
+
+        fclose(file);
+      }
+
+      return count;
+    }
+
+    uint32_t size()
+    {
+      long fileSize = 0;
+
+      FILE *file = fopen(fileName, "r");
+
+      if (file)
+      {
+        if (fseek(file, 0, SEEK_END) == 0)
+          fileSize = ftell(file);
+
+        fclose(file);
+      }
+
+      return (fileSize > 0) ? fileSize : 0;
+    }
+
+    void clear()
+    {
+      remove(fileName);
+    }
+
+  private:
+
+    const char* fileName;
+};
+
 #endif    //WiFiManager_NINA_Lite_RP2040_h
@@ -0,0 +1,218 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Scheduler.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Periodic tasks of the sketch, run by run().
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Scheduler_h
+#define WiFiManager_NINA_Lite_Scheduler_h
+
+// New from v1.5.0
+// run() calls the tasks added by addTask() when due, the earliest deadline first, instead of each sketch keeping its
+// own millis() timeouts in loop(). Tasks are started until none is due or WM_TASK_TIME_SLICE ms have gone, so that
+// run() still checks WiFi and serves the Config Portal between them. A task late by more than its period skips the
+// periods missed, instead of running again and again to catch up.
+#ifndef USE_TASK_SCHEDULER
+  #define USE_TASK_SCHEDULER                false
+#endif
+
+#ifndef WM_MAX_TASKS
+  #define WM_MAX_TASKS                      4
+#endif
+
+#ifndef WM_TASK_TIME_SLICE
+  // ms. No more task is started in a run() after this. The most urgent due task is always started
+  #define WM_TASK_TIME_SLICE                20L
+#endif
+
+typedef void (*WiFiNINA_TaskFunction)();
+
+typedef struct
+{
+  uint32_t      runs;
+  uint32_t      overruns;         // Runs taking longer than the budget
+  uint32_t      missed;           // Runs started after the deadline
+  uint32_t      skipped;          // Periods not run, the task being late by more than a period
+  unsigned long maxRunTime;       // ms
+  unsigned long maxLateness;      // ms from the time due to the start
+} WiFiNINA_TaskStats;
+
+class WiFiNINA_Scheduler
+{
+  public:
+
+    // Run function every period ms, the first time in the next run(). It should start within deadline ms of being due
+    // and take at most budget ms. deadline 0 is the period, budget 0 is no budget.
+    // Return the task, or -1 if WM_MAX_TASKS are added or period is 0
+    int8_t addTask(WiFiNINA_TaskFunction function, unsigned long period, unsigned long deadline = 0,
+                   unsigned long budget = 0)
+    {
+      if ( (numTasks >= WM_MAX_TASKS) || !function || (period == 0) )
+        return -1;
+
+      Task& task = tasks[numTasks];
+
+      task.function = function;
+      task.period   = period;
+      task.deadline = (deadline > 0) ? deadline : period;
+      task.budget   = budget;
+      task.due      = millis();
+      task.enabled  = true;
+
+      memset(&task.stats, 0, sizeof(task.stats));
+
+      return numTasks++;
+    }
+
+    // A task disabled isn't run nor counted late. Enabled, it's due at once
+    void setTaskEnabled(uint8_t task, bool enabled)
+    {
+      if (task >= numTasks)
+        return;
+
+      if (enabled && !tasks[task].enabled)
+        tasks[task].due = millis();
+
+      tasks[task].enabled = enabled;
+    }
+
+    const WiFiNINA_TaskStats& taskStats(uint8_t task) const
+    {
+      return tasks[(task < numTasks) ? task : 0].stats;
+    }
+
+    void resetTaskStats()
+    {
+      for (uint8_t i = 0; i < numTasks; i++)
+      {
+        memset(&tasks[i].stats, 0, sizeof(tasks[i].stats));
+      }
+    }
+
+    uint8_t getNumTasks() const
+    {
+      return numTasks;
+    }
+
+    // ms until a task is due, 0 if one is due now, or none if no task is enabled
+    unsigned long getTimeToNextTask(unsigned long now, unsigned long none = 0xFFFFFFFFUL) const
+    {
+      unsigned long wait = none;
+
+      for (uint8_t i = 0; i < numTasks; i++)
+      {
+        if (!tasks[i].enabled)
+          continue;
+
+        if ( (long) (now - tasks[i].due) >= 0 )
+          return 0;
+
+        if (tasks[i].due - now < wait)
+          wait = tasks[i].due - now;
+      }
+
+      return wait;
+    }
+
+    // Run the due tasks, the earliest deadline first, until none is due or timeSlice ms. Return the tasks run
+    uint8_t runTasks(unsigned long timeSlice)
+    {
+      unsigned long startTime = millis();
+      uint8_t       ran       = 0;
+
+      do
+      {
+        unsigned long now  = millis();
+        int8_t        next = -1;
+
+        for (uint8_t i = 0; i < numTasks; i++)
+        {
+          if ( !tasks[i].enabled || ((long) (now - tasks[i].due) < 0) )
+            continue;
+
+          if ( (next < 0) || ((long) (deadlineOf(i) - deadlineOf(next)) < 0) )
+            next = i;
+        }
+
+        if (next < 0)
+          break;
+
+        runTask(tasks[next], now);
+        ran++;
+      } while (millis() - startTime < timeSlice);
+
+      return ran;
+    }
+
+  private:
+
+    typedef struct
+    {
+      WiFiNINA_TaskFunction function;
+      unsigned long         period;
+      unsigned long         deadline;
+      unsigned long         budget;
+      unsigned long         due;
+      bool                  enabled;
+      WiFiNINA_TaskStats    stats;
+    } Task;
+
+    Task    tasks[WM_MAX_TASKS];
+    uint8_t numTasks = 0;
+
+    unsigned long deadlineOf(uint8_t task) const
+    {
+      return tasks[task].due + tasks[task].deadline;
+    }
+
+    void runTask(Task& task, unsigned long now)
+    {
+      unsigned long lateness = now - task.due;
+
+      if (lateness > task.deadline)
+        task.stats.missed++;
+
+      if (lateness > task.stats.maxLateness)
+        task.stats.maxLateness = lateness;
+
+      task.function();
+
+      unsigned long runTime = millis() - now;
+
+      task.stats.runs++;
+
+      if ( (task.budget > 0) && (runTime > task.budget) )
+      {
+        task.stats.overruns++;
+
+        WN_LOGDEBUG1(F("t:Overrun="), runTime);
+      }
+
+      if (runTime > task.stats.maxRunTime)
+        task.stats.maxRunTime = runTime;
+
+      task.due += task.period;
+
+      // Late by a period or more : skip to the last period due
+      unsigned long behind = millis() - task.due;
+
+      if ( (long) behind >= (long) task.period )
+      {
+        unsigned long periods = behind / task.period;
+
+        task.stats.skipped  += periods;
+        task.due            += periods * task.period;
+      }
+    }
+};
+
+#endif    // WiFiManager_NINA_Lite_Scheduler_h
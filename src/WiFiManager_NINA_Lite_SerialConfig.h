@@ -0,0 +1,327 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_SerialConfig.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Framed binary read / write of the whole Config image over a Stream, for provisioning without Config Portal.
+  Must be included after WiFiManager_NINA_Lite_Storage.h
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_SerialConfig_h
+#define WiFiManager_NINA_Lite_SerialConfig_h
+
+// New from v1.5.0
+// Frame : SOF(0xA5) TYPE(1) LENGTH(2, LE) PAYLOAD(LENGTH) CRC32(4, LE) of TYPE, LENGTH and PAYLOAD
+// Requests  : READ (0x01), WRITE (0x02) with an image, RESET (0x03)
+// Replies   : IMAGE (0x81) to READ, STATUS (0x82) with one status byte to WRITE, RESET and a frame with bad CRC
+// Image     : WiFiNINA_SerialImageHeader, then WiFiNINA_Configuration and each Dynamic Parameter in maxlen bytes.
+// Debug output can share the same port, as 0xA5 is never part of log text, and the host skips anything between frames.
+// Input of the sketch can share it too, unless WM_SERIAL_CONFIG_EXCLUSIVE.
+// See utils/wm_serial_config.py for the host side.
+#ifndef USE_SERIAL_CONFIG
+  #define USE_SERIAL_CONFIG                 false
+#endif
+
+#if USE_SERIAL_CONFIG
+
+#ifndef WM_SERIAL_CONFIG_PORT
+  #define WM_SERIAL_CONFIG_PORT             DBG_PORT_WN
+#endif
+
+#ifndef WM_SERIAL_CONFIG_EXCLUSIVE
+  // false : the sketch can read its own input from the port too. Bytes are only taken from the port from a SOF on, any
+  // other byte is left for the sketch, which must read it, or the frames after it aren't seen.
+  // true : the port is only for Serial Config, bytes between frames are discarded
+  #define WM_SERIAL_CONFIG_EXCLUSIVE        false
+#endif
+
+#ifndef WM_SERIAL_CONFIG_TIMEOUT
+  // Max gap between bytes of a frame, in ms
+  #define WM_SERIAL_CONFIG_TIMEOUT          200L
+#endif
+
+#define WM_SC_SOF                           0xA5
+#define WM_SC_MAGIC                         0x574D5343      // "WMSC"
+
+#define WM_SC_READ                          0x01
+#define WM_SC_WRITE                         0x02
+#define WM_SC_RESET                         0x03
+#define WM_SC_IMAGE                         0x81
+#define WM_SC_STATUS                        0x82
+
+#define WM_SC_OK                            0
+#define WM_SC_ERR_IMAGE                     1       // Wrong magic or length, e.g. image of a sketch with other Dynamic Parameters
+#define WM_SC_ERR_CRC                       2
+#define WM_SC_ERR_TYPE                      3
+
+#define WM_SC_CP_NONE                       0
+#define WM_SC_CP_ONCE                       1
+#define WM_SC_CP_PERSISTENT                 2
+
+typedef struct
+{
+  uint32_t magic;
+  uint16_t length;            // Length of image data following the header
+  uint8_t  forcedCP;          // WM_SC_CP_xxx
+  uint8_t  reserved;
+} WiFiNINA_SerialImageHeader;
+
+class WiFiNINA_SerialConfig
+{
+  public:
+
+    WiFiNINA_SerialConfig() : stream(&WM_SERIAL_CONFIG_PORT)
+    {
+    }
+
+    ~WiFiNINA_SerialConfig()
+    {
+      delete [] image;
+    }
+
+    // Return the type of a complete request with valid CRC, or 0.
+    // Once a frame has started, it's read to the end in this call, so that the RX buffer can't overflow at high baud rates
+    uint8_t poll()
+    {
+      while (true)
+      {
+        if (stream->available() > 0)
+        {
+#if !WM_SERIAL_CONFIG_EXCLUSIVE
+          // Not a frame : left for the sketch
+          if ( (state == WAIT_SOF) && (stream->peek() != WM_SC_SOF) )
+            return 0;
+#endif
+
+          lastByte = millis();
+
+          if (receive((uint8_t) stream->read()))
+          {
+            state = WAIT_SOF;
+
+            if (crc != receivedCRC)
+            {
+              WN_LOGDEBUG(F("SC:Bad CRC"));
+              releaseImage();
+              sendStatus(WM_SC_ERR_CRC);
+
+              return 0;
+            }
+
+            if ( (type != WM_SC_READ) && (type != WM_SC_WRITE) && (type != WM_SC_RESET) )
+            {
+              sendStatus(WM_SC_ERR_TYPE);
+
+              return 0;
+            }
+
+            return type;
+          }
+        }
+        else if ( (state == WAIT_SOF) || (millis() - lastByte > WM_SERIAL_CONFIG_TIMEOUT) )
+        {
+          // A frame cut short doesn't keep its image
+          if (state != WAIT_SOF)
+            releaseImage();
+
+          state = WAIT_SOF;
+
+          return 0;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////
+
+    void sendImage(const WiFiNINA_Configuration& config, uint8_t forcedCP)
+    {
+      WiFiNINA_SerialImageHeader header = { WM_SC_MAGIC, WiFiNINA_slotDataSize(), forcedCP, 0 };
+
+      uint32_t frameCRC = beginFrame(WM_SC_IMAGE, sizeof(header) + header.length);
+
+      frameCRC = writeData((const uint8_t*) &header, sizeof(header), frameCRC);
+      frameCRC = writeData((const uint8_t*) &config, sizeof(config), frameCRC);
+
+#if USE_DYNAMIC_PARAMETERS
+      for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+      {
+        frameCRC = writeData((const uint8_t*) myMenuItems[i].pdata, myMenuItems[i].maxlen, frameCRC);
+      }
+#endif
+
+      endFrame(frameCRC);
+    }
+
+    //////////////////////////////////////////////
+
+    void sendStatus(uint8_t status)
+    {
+      endFrame(writeData(&status, 1, beginFrame(WM_SC_STATUS, 1)));
+    }
+
+    //////////////////////////////////////////////
+
+    // After a WRITE request : unpack the received image into config and Dynamic Parameters
+    uint8_t getImage(WiFiNINA_Configuration& config, uint8_t& forcedCP)
+    {
+      uint8_t status = WM_SC_ERR_IMAGE;
+
+      if (image && (received == imageSize))
+      {
+        WiFiNINA_SerialImageHeader header;
+
+        memcpy(&header, image, sizeof(header));
+
+        if ( (header.magic == WM_SC_MAGIC) && (header.length == imageSize - sizeof(header)) )
+        {
+          WiFiNINA_unpackSlotData(image + sizeof(header), config);
+          forcedCP = header.forcedCP;
+          status   = WM_SC_OK;
+        }
+      }
+
+      releaseImage();
+
+      return status;
+    }
+
+  private:
+
+    enum { WAIT_SOF, TYPE, LENGTH_LO, LENGTH_HI, PAYLOAD, CRC };
+
+    Stream*       stream;
+    uint8_t       state     = WAIT_SOF;
+    uint8_t       type      = 0;
+    uint16_t      length    = 0;
+    uint16_t      received  = 0;
+    uint8_t       crcBytes  = 0;
+    uint32_t      crc       = 0;
+    uint32_t      receivedCRC;
+    unsigned long lastByte  = 0;
+
+    uint8_t*      image     = NULL;
+    uint16_t      imageSize = 0;
+
+    // Only needed while provisioning
+    void releaseImage()
+    {
+      delete [] image;
+      image = NULL;
+    }
+
+    //////////////////////////////////////////////
+
+    // Feed one byte. Return true when a whole frame is received
+    bool receive(uint8_t c)
+    {
+      if (state == WAIT_SOF)
+      {
+        if (c == WM_SC_SOF)
+        {
+          state = TYPE;
+          crc   = 0;
+        }
+
+        return false;
+      }
+
+      if (state == CRC)
+      {
+        receivedCRC = (crcBytes == 0) ? c : ( receivedCRC | ((uint32_t) c << (8 * crcBytes)) );
+
+        return (++crcBytes == 4);
+      }
+
+      crc = WiFiNINA_crc32(&c, 1, crc);
+
+      switch (state)
+      {
+        case TYPE:
+          type  = c;
+          state = LENGTH_LO;
+          break;
+
+        case LENGTH_LO:
+          length = c;
+          state  = LENGTH_HI;
+          break;
+
+        case LENGTH_HI:
+          length   |= (uint16_t) c << 8;
+          received  = 0;
+          crcBytes  = 0;
+          imageSize = sizeof(WiFiNINA_SerialImageHeader) + WiFiNINA_slotDataSize();
+
+          // Nothing longer than an image is valid. Wait for the next SOF
+          if (length > imageSize)
+          {
+            releaseImage();
+            state = WAIT_SOF;
+
+            return false;
+          }
+
+          if ( (type == WM_SC_WRITE) && (length == imageSize) && !image )
+          {
+            image = new uint8_t[imageSize];
+          }
+
+          state = (length > 0) ? PAYLOAD : CRC;
+          break;
+
+        case PAYLOAD:
+          if ( image && (type == WM_SC_WRITE) && (length == imageSize) )
+            image[received] = c;
+
+          received++;
+
+          if (received == length)
+            state = CRC;
+
+          break;
+      }
+
+      return false;
+    }
+
+    //////////////////////////////////////////////
+
+    uint32_t beginFrame(uint8_t frameType, uint16_t frameLength)
+    {
+      uint8_t frameHeader[4] = { WM_SC_SOF, frameType, (uint8_t) frameLength, (uint8_t) (frameLength >> 8) };
+
+      stream->write(frameHeader, sizeof(frameHeader));
+
+      return WiFiNINA_crc32(&frameHeader[1], 3);
+    }
+
+    //////////////////////////////////////////////
+
+    uint32_t writeData(const uint8_t* data, uint16_t dataLength, uint32_t frameCRC)
+    {
+      stream->write(data, dataLength);
+
+      return WiFiNINA_crc32(data, dataLength, frameCRC);
+    }
+
+    //////////////////////////////////////////////
+
+    void endFrame(uint32_t frameCRC)
+    {
+      uint8_t crcBytes[4] = { (uint8_t) frameCRC, (uint8_t) (frameCRC >> 8), (uint8_t) (frameCRC >> 16), (uint8_t) (frameCRC >> 24) };
+
+      stream->write(crcBytes, sizeof(crcBytes));
+      stream->flush();
+    }
+};
+
+#endif    // USE_SERIAL_CONFIG
+
+#endif    // WiFiManager_NINA_Lite_SerialConfig_h
@@ -0,0 +1,45 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Service.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Services run by run(), such as WiFiNINA_MQTT_Service.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Service_h
+#define WiFiManager_NINA_Lite_Service_h
+
+// New from v1.5.0
+// run() gives each service added by addService() a time slice, after checking WiFi. A service does its work in steps
+// that don't wait, such as keeping an MQTT session, instead of the sketch blocking loop() to do it.
+#ifndef USE_RUN_SERVICES
+  #define USE_RUN_SERVICES                  false
+#endif
+
+#ifndef WM_MAX_SERVICES
+  #define WM_MAX_SERVICES                   2
+#endif
+
+#ifndef WM_SERVICE_TIME_SLICE
+  // ms. Time a service should return within, in each run()
+  #define WM_SERVICE_TIME_SLICE             20L
+#endif
+
+class WiFiNINA_Service
+{
+  public:
+
+    virtual ~WiFiNINA_Service() {}
+
+    // Called in each run(). wifiConnected as known by run(), false in Config Portal mode. Don't wait
+    virtual void runService(bool wifiConnected, unsigned long timeSlice) = 0;
+};
+
+#endif    // WiFiManager_NINA_Lite_Service_h
@@ -0,0 +1,41 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Spool.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Storage a spool, such as WiFiNINA_MQTT_Spool, writes to when its RAM is full.
+  WiFiNINA_FileSpool, a LittleFS file, is declared by the nRF52 and RP2040 board headers.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Spool_h
+#define WiFiManager_NINA_Lite_Spool_h
+
+// New from v1.5.0
+// Append-only : data is added at the end, read from any offset, and all removed at once when read. The spool writes
+// its whole RAM at a time, and doesn't write when it reads, so that flash is written as little as possible.
+class WiFiNINA_SpoolStorage
+{
+  public:
+
+    virtual ~WiFiNINA_SpoolStorage() {}
+
+    // Add length bytes at the end. Return false if not all are written
+    virtual bool append(const uint8_t* data, uint16_t length) = 0;
+
+    // Read up to length bytes from offset. Return the bytes read, fewer at the end
+    virtual uint16_t read(uint32_t offset, uint8_t* data, uint16_t length) = 0;
+
+    // Bytes stored, 0 if none
+    virtual uint32_t size() = 0;
+
+    virtual void clear() = 0;
+};
+
+#endif    // WiFiManager_NINA_Lite_Spool_h
@@ -0,0 +1,222 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_StaticIP.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Static IP configuration and sticky DHCP lease.
+  Must be included after WiFiManager_NINA_Lite_MenuItem.h, and before WiFiNINA_Configuration is declared.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_StaticIP_h
+#define WiFiManager_NINA_Lite_StaticIP_h
+
+// New from v1.5.0
+// Static IP, gateway, subnet mask and DNS, edited in Config Portal (keys ip, gw, sn, dns) and stored in Config Data.
+// An empty IP means DHCP. Takes precedence over setSTAStaticIPConfig(). Changes the storage layout.
+#ifndef USE_STATIC_IP_CONFIG
+  #define USE_STATIC_IP_CONFIG              false
+#endif
+
+// New from v1.5.0
+// Keep the last DHCP lease in Config Data, and reuse it as a static IP on the next boot or reconnect to the same SSID,
+// so that DHCP is not waited for. WiFiNINA doesn't report the lease time, so a reused lease is checked by pinging the
+// gateway, and dropped for a new DHCP if the connection or the ping fails. A DHCP reservation for the board is best.
+// The DNS of a reused lease is the gateway. Changes the storage layout.
+#ifndef USE_STICKY_DHCP
+  #define USE_STICKY_DHCP                   false
+#endif
+
+#ifndef WM_STICKY_DHCP_VERIFY
+  // Ping the gateway after connecting with a reused lease. Disable if the gateway doesn't answer ping
+  #define WM_STICKY_DHCP_VERIFY             true
+#endif
+
+#if USE_STATIC_IP_CONFIG
+  #define WM_NUM_STATIC_IP_ITEMS            4
+#else
+  #define WM_NUM_STATIC_IP_ITEMS            0
+#endif
+
+#define WM_IP_DHCP                          0
+#define WM_IP_STATIC                        1
+#define WM_IP_LEASE                         2
+
+typedef struct
+{
+  uint8_t ip      [4];
+  uint8_t gateway [4];
+  uint8_t subnet  [4];
+  uint8_t dns     [4];
+} WiFiNINA_IPConfig;
+
+typedef struct
+{
+  WiFiNINA_IPConfig ipConfig;
+  uint8_t           index;          // WiFi_Creds the lease was obtained with
+  uint8_t           reserved[3];
+} WiFiNINA_DHCPLease;
+
+//////////////////////////////////////////////
+
+inline bool WiFiNINA_isIPSet(const uint8_t* octet)
+{
+  return ( (octet[0] | octet[1] | octet[2] | octet[3]) != 0 );
+}
+
+//////////////////////////////////////////////
+
+inline IPAddress WiFiNINA_toIPAddress(const uint8_t* octet)
+{
+  return IPAddress(octet[0], octet[1], octet[2], octet[3]);
+}
+
+//////////////////////////////////////////////
+
+// Only the IP set : as WiFi.config(ip). Else the missing gateway, subnet mask and DNS are x.x.x.1, 255.255.255.0 and
+// the gateway
+inline void WiFiNINA_configStaticIP(const IPAddress& ip, const IPAddress& gateway, const IPAddress& subnet, const IPAddress& dns)
+{
+  const IPAddress none(0, 0, 0, 0);
+
+  if ( (gateway == none) && (subnet == none) && (dns == none) )
+  {
+    WiFi.config(ip);
+
+    return;
+  }
+
+  IPAddress gatewayIP = (gateway == none) ? IPAddress(ip[0], ip[1], ip[2], 1) : gateway;
+
+  WiFi.config(ip, (dns == none) ? gatewayIP : dns, gatewayIP, (subnet == none) ? IPAddress(255, 255, 255, 0) : subnet);
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_configStaticIP(const WiFiNINA_IPConfig& config)
+{
+  WiFiNINA_configStaticIP(WiFiNINA_toIPAddress(config.ip), WiFiNINA_toIPAddress(config.gateway),
+                          WiFiNINA_toIPAddress(config.subnet), WiFiNINA_toIPAddress(config.dns));
+}
+
+//////////////////////////////////////////////
+
+#if USE_STICKY_DHCP
+
+inline void WiFiNINA_readDHCPLease(WiFiNINA_DHCPLease& lease, uint8_t index)
+{
+  IPAddress ip      = WiFi.localIP();
+  IPAddress gateway = WiFi.gatewayIP();
+  IPAddress subnet  = WiFi.subnetMask();
+
+  memset(&lease, 0, sizeof(lease));
+
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    lease.ipConfig.ip[i]      = ip[i];
+    lease.ipConfig.gateway[i] = gateway[i];
+    lease.ipConfig.subnet[i]  = subnet[i];
+    lease.ipConfig.dns[i]     = gateway[i];
+  }
+
+  lease.index = index;
+}
+
+//////////////////////////////////////////////
+
+inline bool WiFiNINA_verifyDHCPLease(const WiFiNINA_DHCPLease& lease)
+{
+#if WM_STICKY_DHCP_VERIFY
+  return (WiFi.ping(WiFiNINA_toIPAddress(lease.ipConfig.gateway)) >= 0);
+#else
+  (void) lease;
+
+  return true;
+#endif
+}
+
+#endif    // USE_STICKY_DHCP
+
+//////////////////////////////////////////////
+
+#if USE_STATIC_IP_CONFIG
+
+const char WIFININA_HTML_STATIC_IP[] /*PROGMEM*/ = "<div><label>Static IP (empty for DHCP)</label><input value='[[ip]]' id='ip'><div></div></div>\
+<div><label>Gateway</label><input value='[[gw]]' id='gw'><div></div></div>\
+<div><label>Subnet Mask</label><input value='[[sn]]' id='sn'><div></div></div>\
+<div><label>DNS</label><input value='[[dns]]' id='dns'><div></div></div>";
+
+//////////////////////////////////////////////
+
+// Field for Config Portal key ip, gw, sn or dns, else NULL
+inline uint8_t* WiFiNINA_staticIPField(WiFiNINA_IPConfig& config, uint8_t builtinKey)
+{
+  switch (builtinKey)
+  {
+    case WM_KEY_IP:
+      return config.ip;
+    case WM_KEY_GW:
+      return config.gateway;
+    case WM_KEY_SN:
+      return config.subnet;
+    case WM_KEY_DNS:
+      return config.dns;
+  }
+
+  return NULL;
+}
+
+//////////////////////////////////////////////
+
+// Empty text for 0.0.0.0. Return false and keep the field if invalid
+inline bool WiFiNINA_setStaticIPField(uint8_t* octet, const char* text)
+{
+  if (text[0] == 0)
+  {
+    memset(octet, 0, 4);
+
+    return true;
+  }
+
+  uint8_t value[4];
+
+  if (!WiFiNINA_parseIP(text, value))
+    return false;
+
+  memcpy(octet, value, 4);
+
+  return true;
+}
+
+//////////////////////////////////////////////
+
+inline String WiFiNINA_staticIPFieldToString(const uint8_t* octet)
+{
+  if (!WiFiNINA_isIPSet(octet))
+    return String("");
+
+  return String(octet[0]) + "." + octet[1] + "." + octet[2] + "." + octet[3];
+}
+
+//////////////////////////////////////////////
+
+// Fill [[ip]], [[gw]], [[sn]] and [[dns]] of Config Portal page. Empty if config is NULL
+inline void WiFiNINA_replaceStaticIP(String& html, WiFiNINA_IPConfig* config)
+{
+  static const char* const keys[] = { "[[ip]]", "[[gw]]", "[[sn]]", "[[dns]]" };
+
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    html.replace(keys[i], config ? WiFiNINA_staticIPFieldToString(WiFiNINA_staticIPField(*config, WM_KEY_IP + i)) : String(""));
+  }
+}
+
+#endif    // USE_STATIC_IP_CONFIG
+
+#endif    // WiFiManager_NINA_Lite_StaticIP_h
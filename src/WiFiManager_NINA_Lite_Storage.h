@@ -0,0 +1,191 @@
+/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_Storage.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Storage helpers shared by all board-specific storage backends.
+  Must be included after WiFiNINA_Configuration, MenuItem and myMenuItems are declared.
+  **********************************************************************************************************************************/
+
+#ifndef WiFiManager_NINA_Lite_Storage_h
+#define WiFiManager_NINA_Lite_Storage_h
+
+// New from v1.5.0
+// Keep two copies (slots) of Config and Dynamic Data. A save always goes to the inactive slot, is verified, then
+// becomes active by having a newer generation in its header. A power loss during save leaves the old slot intact.
+// Changes the storage layout, so stored data from older versions is not read back.
+// Each slot is a file on nRF52 and RP2040 (LittleFS), written byte by byte to EEPROM on AVR Mega and Teensy, and on
+// its own flash pages on SAM DUE. Not on SAMD and STM32, whose emulated EEPROM is one flash page holding both slots,
+// committed at once.
+#ifndef USE_CONFIG_AB_SLOTS
+  #define USE_CONFIG_AB_SLOTS       false
+#endif
+
+// New from v1.5.0
+// nRF52 and RP2040 (LittleFS) only. Keep Config, Dynamic Data and the forced Config Portal flag in one packed file,
+// written with one write() and read with one read(), instead of the separate config, credentials and CP files
+// and their backups. LittleFS commits a file atomically on close, so no backup file is needed.
+// The older files are migrated into the packed file on first boot, then removed.
+#ifndef USE_PACKED_CONFIG_FILE
+  #define USE_PACKED_CONFIG_FILE    false
+#endif
+
+#if (USE_CONFIG_AB_SLOTS && USE_PACKED_CONFIG_FILE)
+  #error USE_CONFIG_AB_SLOTS and USE_PACKED_CONFIG_FILE cannot be used together
+#endif
+
+// Small nibble-table CRC32 (IEEE 802.3), 64 bytes of table instead of 1KB
+inline uint32_t WiFiNINA_crc32(const uint8_t* data, uint16_t length, uint32_t crc = 0)
+{
+  static const uint32_t crcTable[16] =
+  {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+
+  crc = ~crc;
+
+  for (uint16_t i = 0; i < length; i++)
+  {
+    crc = crcTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+    crc = crcTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+  }
+
+  return ~crc;
+}
+
+//////////////////////////////////////////////
+
+// Slot / Packed / Serial Config image data : WiFiNINA_Configuration, then each dynamic item in maxlen bytes
+inline uint16_t WiFiNINA_slotDataSize()
+{
+  uint16_t dataSize = sizeof(WiFiNINA_Configuration);
+
+#if USE_DYNAMIC_PARAMETERS
+  for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+  {
+    dataSize += myMenuItems[i].maxlen;
+  }
+#endif
+
+  return dataSize;
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_packSlotData(uint8_t* data, const WiFiNINA_Configuration& config)
+{
+  memcpy(data, &config, sizeof(config));
+  data += sizeof(config);
+
+#if USE_DYNAMIC_PARAMETERS
+  for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+  {
+    memcpy(data, myMenuItems[i].pdata, myMenuItems[i].maxlen);
+    data += myMenuItems[i].maxlen;
+  }
+#endif
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_unpackSlotData(const uint8_t* data, WiFiNINA_Configuration& config)
+{
+  memcpy(&config, data, sizeof(config));
+  data += sizeof(config);
+
+#if USE_DYNAMIC_PARAMETERS
+  for (uint16_t i = 0; i < NUM_MENU_ITEMS; i++)
+  {
+    WiFiNINA_clearMenuItem(myMenuItems[i]);
+    memcpy(myMenuItems[i].pdata, data, myMenuItems[i].maxlen);
+    data += myMenuItems[i].maxlen;
+  }
+#endif
+}
+
+//////////////////////////////////////////////
+
+#if (USE_CONFIG_AB_SLOTS || USE_PACKED_CONFIG_FILE)
+
+#define WM_NUM_SLOTS                2
+#define WM_SLOT_MAGIC               0x574D4142      // "WMAB"
+#define WM_PACKED_MAGIC             0x574D504B      // "WMPK"
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t generation;
+  uint32_t length;            // Length of slot data following the header
+  uint32_t crc;               // CRC32 of slot data
+} WiFiNINA_SlotHeader;
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t length;            // Length of packed data following the header
+  uint32_t forcedCPFlag;      // Not covered by crc. Only the exact flag values are acted upon
+  uint32_t crc;               // CRC32 of packed data
+} WiFiNINA_PackedHeader;
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_initSlotHeader(WiFiNINA_SlotHeader& header, const uint8_t* data, uint16_t dataSize, uint32_t generation)
+{
+  header.magic      = WM_SLOT_MAGIC;
+  header.generation = generation;
+  header.length     = dataSize;
+  header.crc        = WiFiNINA_crc32(data, dataSize);
+}
+
+//////////////////////////////////////////////
+
+inline void WiFiNINA_initPackedHeader(WiFiNINA_PackedHeader& header, const uint8_t* data, uint16_t dataSize, uint32_t forcedCPFlag)
+{
+  header.magic        = WM_PACKED_MAGIC;
+  header.length       = dataSize;
+  header.forcedCPFlag = forcedCPFlag;
+  header.crc          = WiFiNINA_crc32(data, dataSize);
+}
+
+//////////////////////////////////////////////
+
+inline bool WiFiNINA_isSlotHeaderValid(const WiFiNINA_SlotHeader& header, uint16_t dataSize)
+{
+  return ( (header.magic == WM_SLOT_MAGIC) && (header.length == dataSize) );
+}
+
+//////////////////////////////////////////////
+
+// Order the slots by generation, newest valid first. Wrap-around safe.
+// Returns the number of slots with a valid header, to be tried in order[0], order[1]
+inline uint8_t WiFiNINA_orderSlots(const WiFiNINA_SlotHeader* header, uint16_t dataSize, uint8_t* order)
+{
+  bool valid0 = WiFiNINA_isSlotHeaderValid(header[0], dataSize);
+  bool valid1 = WiFiNINA_isSlotHeaderValid(header[1], dataSize);
+
+  if (valid0 && valid1)
+  {
+    bool newer1 = ( (int32_t) (header[1].generation - header[0].generation) > 0 );
+
+    order[0] = newer1 ? 1 : 0;
+    order[1] = newer1 ? 0 : 1;
+
+    return 2;
+  }
+
+  order[0] = valid1 ? 1 : 0;
+
+  return (valid0 || valid1) ? 1 : 0;
+}
+
+#endif    // (USE_CONFIG_AB_SLOTS || USE_PACKED_CONFIG_FILE)
+
+#endif    // WiFiManager_NINA_Lite_Storage_h
@@ -0,0 +1,98 @@
+// Host mock of Adafruit_MQTT_Client.cpp of the Adafruit MQTT Library v2.4.x, with the same byte by byte readPacket().
+// Also the AVR libc number conversions used by Adafruit_MQTT.cpp
+
+#include "Adafruit_MQTT_Client.h"
+
+extern "C"
+{
+  char* itoa(int value, char *string, int radix)
+  {
+    sprintf(string, (radix == 16) ? "%x" : "%d", value);
+    return string;
+  }
+
+  char* ltoa(long value, char *string, int radix)
+  {
+    sprintf(string, (radix == 16) ? "%lx" : "%ld", value);
+    return string;
+  }
+
+  char* utoa(unsigned value, char *string, int radix)
+  {
+    sprintf(string, (radix == 16) ? "%x" : "%u", value);
+    return string;
+  }
+
+  char* ultoa(unsigned long value, char *string, int radix)
+  {
+    sprintf(string, (radix == 16) ? "%lx" : "%lu", value);
+    return string;
+  }
+}
+
+bool Adafruit_MQTT_Client::connectServer()
+{
+  return client->connect(servername, portnum);
+}
+
+bool Adafruit_MQTT_Client::disconnectServer()
+{
+  if (connected())
+    client->stop();
+
+  return true;
+}
+
+bool Adafruit_MQTT_Client::connected()
+{
+  return client->connected();
+}
+
+uint16_t Adafruit_MQTT_Client::readPacket(uint8_t *buffer, uint16_t maxlen, int16_t timeout)
+{
+  uint16_t len = 0;
+  int16_t  t   = timeout;
+
+  if (maxlen == 0)
+    return 0;
+
+  while (client->connected() && (timeout >= 0))
+  {
+    while (client->available())
+    {
+      char c = client->read();
+
+      timeout     = t;
+      buffer[len] = c;
+      len++;
+
+      if (len == maxlen)
+        return len;
+    }
+
+    timeout -= MQTT_CLIENT_READINTERVAL_MS;
+    delay(MQTT_CLIENT_READINTERVAL_MS);
+  }
+
+  return len;
+}
+
+bool Adafruit_MQTT_Client::sendPacket(uint8_t *buffer, uint16_t len)
+{
+  while (len > 0)
+  {
+    if (!client->connected())
+      return false;
+
+    uint16_t sendlen = (len > 250) ? 250 : len;
+    uint16_t ret     = client->write(buffer, sendlen);
+
+    len    -= ret;
+    buffer += ret;
+
+    if (ret != sendlen)
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Host mock of Adafruit_MQTT_Client.h of the Adafruit MQTT Library v2.4.x
+
+#include "Adafruit_MQTT.h"
+
+#define MQTT_CLIENT_READINTERVAL_MS 10
+
+class Adafruit_MQTT_Client : public Adafruit_MQTT
+{
+  public:
+    Adafruit_MQTT_Client(Client *client, const char *server, uint16_t port, const char *cid, const char *user, const char *pass)
+      : Adafruit_MQTT(server, port, cid, user, pass), client(client) {}
+    Adafruit_MQTT_Client(Client *client, const char *server, uint16_t port, const char *user = "", const char *pass = "")
+      : Adafruit_MQTT(server, port, user, pass), client(client) {}
+
+    bool connectServer();
+    bool disconnectServer();
+    bool connected();
+    uint16_t readPacket(uint8_t *buffer, uint16_t maxlen, int16_t timeout);
+    bool sendPacket(uint8_t *buffer, uint16_t len);
+
+  private:
+    Client *client;
+};
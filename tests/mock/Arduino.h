@@ -0,0 +1,194 @@
+#pragma once
+// Host mock of the subset of the Arduino API used by the library headers. Time only moves by delay() or by
+// the tests setting mock_millis, so that the results are the same on each run
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+typedef uint8_t byte;
+typedef bool boolean;
+#define HEX 16
+#define DEC 10
+#define F(x) (x)
+#define PROGMEM
+#define PGM_P const char*
+#define memcpy_P memcpy
+#define __FlashStringHelper char
+using std::min; using std::max;
+
+extern unsigned long mock_millis;
+inline unsigned long millis() { return mock_millis; }
+inline unsigned long micros() { return mock_millis * 1000; }
+inline void delay(unsigned long ms) { mock_millis += ms; }
+inline void yield() {}
+
+// itoa.h of the cores. Defined in Adafruit_MQTT_Client.cpp, the only tests using them
+extern "C"
+{
+  char* itoa(int value, char *string, int radix);
+  char* ltoa(long value, char *string, int radix);
+  char* utoa(unsigned value, char *string, int radix);
+  char* ultoa(unsigned long value, char *string, int radix);
+}
+inline long random(long m) { return rand() % (m ? m : 1); }
+inline long random(long a, long b) { return a + rand() % ((b - a) ? (b - a) : 1); }
+inline void randomSeed(unsigned long s) { srand(s); }
+inline int analogRead(int) { return 0; }
+inline int& mock_resets() { static int n = 0; return n; }
+inline void NVIC_SystemReset() { mock_resets()++; printf("** NVIC_SystemReset **\n"); }
+inline void __WFI() {}
+inline void __DSB() {}
+
+class IPAddress;
+
+class String
+{
+  public:
+    std::string s;
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& x) : s(x) {}
+    String(char c) : s(1, c) {}
+    String(int v, int base = 10) { char b[40]; if (base == 16) snprintf(b, sizeof b, "%x", v); else snprintf(b, sizeof b, "%d", v); s = b; }
+    String(unsigned int v, int base = 10) { char b[40]; snprintf(b, sizeof b, base == 16 ? "%x" : "%u", v); s = b; }
+    String(long v, int base = 10) { char b[40]; snprintf(b, sizeof b, base == 16 ? "%lx" : "%ld", v); s = b; }
+    String(unsigned long v, int base = 10) { char b[40]; snprintf(b, sizeof b, base == 16 ? "%lx" : "%lu", v); s = b; }
+    String(float v, int dec = 2) { char b[40]; snprintf(b, sizeof b, "%.*f", dec, v); s = b; }
+    String(double v, int dec = 2) { char b[40]; snprintf(b, sizeof b, "%.*f", dec, v); s = b; }
+    unsigned int length() const { return s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    bool reserve(unsigned int n) { s.reserve(n); return true; }
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { s += o; return *this; }
+    String& operator+=(char o) { s += o; return *this; }
+    String& operator+=(int o) { s += String(o).s; return *this; }
+    String& operator+=(unsigned int o) { s += String(o).s; return *this; }
+    String& operator+=(long o) { s += String(o).s; return *this; }
+    String& operator+=(unsigned long o) { s += String(o).s; return *this; }
+    bool concat(const char* o) { s += o; return true; }
+    bool concat(const String& o) { s += o.s; return true; }
+    bool concat(char o) { s += o; return true; }
+    friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+    friend String operator+(const String& a, const char* b) { return String(a.s + b); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+    friend String operator+(const String& a, char b) { return String(a.s + b); }
+    friend String operator+(const String& a, int b) { return String(a.s + String(b).s); }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o) const { return s == o; }
+    bool operator!=(const String& o) const { return s != o.s; }
+    bool operator!=(const char* o) const { return s != o; }
+    char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+    bool equals(const String& o) const { return s == o.s; }
+    bool equalsIgnoreCase(const String& o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+    bool startsWith(const String& o) const { return s.compare(0, o.s.size(), o.s) == 0; }
+    bool endsWith(const String& o) const { return s.size() >= o.s.size() && s.compare(s.size() - o.s.size(), o.s.size(), o.s) == 0; }
+    int indexOf(char c, unsigned int from = 0) const { auto p = s.find(c, from); return p == std::string::npos ? -1 : (int) p; }
+    int indexOf(const String& c, unsigned int from = 0) const { auto p = s.find(c.s, from); return p == std::string::npos ? -1 : (int) p; }
+    int lastIndexOf(char c) const { auto p = s.rfind(c); return p == std::string::npos ? -1 : (int) p; }
+    String substring(unsigned int a) const { return a < s.size() ? String(s.substr(a)) : String(); }
+    String substring(unsigned int a, unsigned int b) const { if (a > b) std::swap(a, b); if (a >= s.size()) return String(); return String(s.substr(a, b - a)); }
+    void replace(const String& f, const String& r) { if (f.s.empty()) return; size_t p = 0; while ((p = s.find(f.s, p)) != std::string::npos) { s.replace(p, f.s.size(), r.s); p += r.s.size(); } }
+    void remove(unsigned int i) { if (i < s.size()) s.erase(i); }
+    void remove(unsigned int i, unsigned int n) { if (i < s.size()) s.erase(i, n); }
+    void trim() { while (!s.empty() && isspace((unsigned char)s.back())) s.pop_back(); size_t i = 0; while (i < s.size() && isspace((unsigned char)s[i])) i++; s.erase(0, i); }
+    void toLowerCase() { for (auto& c : s) c = tolower(c); }
+    void toUpperCase() { for (auto& c : s) c = toupper(c); }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    void toCharArray(char* buf, unsigned int n) const { if (!n) return; strncpy(buf, s.c_str(), n - 1); buf[n - 1] = 0; }
+    void getBytes(unsigned char* buf, unsigned int n) const { toCharArray((char*) buf, n); }
+    explicit operator bool() const { return true; }
+};
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* b, size_t n) { size_t r = 0; while (n--) r += write(*b++); return r; }
+    size_t write(const char* str) { return write((const uint8_t*) str, strlen(str)); }
+    size_t write(const char* b, size_t n) { return write((const uint8_t*) b, n); }
+    virtual void flush() {}
+    size_t print(const char* x) { return write(x); }
+    size_t print(const String& x) { return write(x.c_str()); }
+    size_t print(char c) { return write((uint8_t) c); }
+    size_t print(int x, int base = 10) { return print(String(x, base)); }
+    size_t print(unsigned int x, int base = 10) { return print(String(x, base)); }
+    size_t print(long x, int base = 10) { return print(String(x, base)); }
+    size_t print(unsigned long x, int base = 10) { return print(String(x, base)); }
+    size_t print(double x, int d = 2) { return print(String(x, d)); }
+    size_t print(const IPAddress& ip);
+    template <typename T> size_t println(const T& x) { size_t n = print(x); return n + println(); }
+    template <typename T> size_t println(const T& x, int b) { size_t n = print(x, b); return n + println(); }
+    size_t println() { return write("\r\n"); }
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    unsigned long _timeout = 1000;
+    void setTimeout(unsigned long t) { _timeout = t; }
+    virtual size_t readBytes(uint8_t* b, size_t n) { size_t i = 0; while (i < n) { int c = read(); if (c < 0) break; b[i++] = c; } return i; }
+    size_t readBytes(char* b, size_t n) { return readBytes((uint8_t*) b, n); }
+};
+
+class MockSerial : public Stream
+{
+  public:
+    std::string in;
+    bool quiet = false;
+    size_t write(uint8_t c) override { if (!quiet) putchar(c); return 1; }
+    int available() override { return in.size(); }
+    int read() override { if (in.empty()) return -1; int c = (uint8_t) in[0]; in.erase(0, 1); return c; }
+    int peek() override { return in.empty() ? -1 : (uint8_t) in[0]; }
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+};
+extern MockSerial Serial;
+
+class IPAddress
+{
+  public:
+    uint8_t b[4] = {0, 0, 0, 0};
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t c, uint8_t d, uint8_t e) { b[0] = a; b[1] = c; b[2] = d; b[3] = e; }
+    IPAddress(uint32_t v) { memcpy(b, &v, 4); }
+    operator uint32_t() const { uint32_t v; memcpy(&v, b, 4); return v; }
+    uint8_t operator[](int i) const { return b[i]; }
+    uint8_t& operator[](int i) { return b[i]; }
+    bool operator==(const IPAddress& o) const { return memcmp(b, o.b, 4) == 0; }
+    bool operator!=(const IPAddress& o) const { return !(*this == o); }
+    bool fromString(const char* s) { unsigned a, c, d, e; if (sscanf(s, "%u.%u.%u.%u", &a, &c, &d, &e) != 4 || a > 255 || c > 255 || d > 255 || e > 255) return false; b[0] = a; b[1] = c; b[2] = d; b[3] = e; return true; }
+    bool fromString(const String& s) { return fromString(s.c_str()); }
+    String toString() const { char t[20]; snprintf(t, sizeof t, "%u.%u.%u.%u", b[0], b[1], b[2], b[3]); return String(t); }
+};
+inline size_t Print::print(const IPAddress& ip) { return print(ip.toString()); }
+
+class Client : public Stream
+{
+  public:
+    virtual int connect(IPAddress ip, uint16_t port) = 0;
+    virtual int connect(const char* host, uint16_t port) = 0;
+    virtual uint8_t connected() = 0;
+    virtual void stop() = 0;
+    virtual int read(uint8_t* buf, size_t size) = 0;
+    using Stream::read;
+    using Print::write;
+    virtual operator bool() = 0;
+};
+
+// SAMD21 WDT mock
+struct MockWDTReg { uint32_t reg; struct { uint32_t SYNCBUSY, WEN; } bit; };
+struct MockWDT { MockWDTReg CONFIG, CTRL, CLEAR, STATUS, CTRLA, SYNCBUSY; };
+extern MockWDT mockWDT;
+#define WDT (&mockWDT)
+#define WDT_CTRL_ENABLE 2
@@ -0,0 +1,20 @@
+#pragma once
+
+// Host mock of DoubleResetDetector_Generic. A double reset is detected when the test sets mock_drd
+
+#include "Arduino.h"
+
+#define DRD_FLAG_DATA_SIZE      4
+
+class DoubleResetDetector_Generic
+{
+  public:
+    DoubleResetDetector_Generic(int timeout, int address) {}
+
+    bool detectDoubleReset()    { return mock_drd; }
+    void loop()                 { loops++; }
+    void stop() {}
+
+    static bool mock_drd;
+    int         loops = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+// Host mock of the EEPROM libraries. data is what EEPROM.read() returns, flash what is left after a reboot : only
+// commit() writes it, as FlashStorage_SAMD and the emulated EEPROM of other cores. Define MOCK_EEPROM_WRITE_THROUGH for
+// a real EEPROM (AVR, Teensy), written at once
+
+#include "Arduino.h"
+
+#ifndef MOCK_EEPROM_SIZE
+  #define MOCK_EEPROM_SIZE      4096
+#endif
+
+struct MockEEPROM
+{
+  uint8_t data[MOCK_EEPROM_SIZE];
+  uint8_t flash[MOCK_EEPROM_SIZE];
+  int     writes  = 0;
+  int     commits = 0;
+
+  MockEEPROM()
+  {
+    memset(data,  0xFF, sizeof(data));
+    memset(flash, 0xFF, sizeof(flash));
+  }
+
+  void begin() {}
+  void init() {}
+  uint16_t length()                   { return MOCK_EEPROM_SIZE; }
+  uint8_t read(int address)           { return data[address]; }
+
+  void write(int address, uint8_t value)
+  {
+    data[address] = value;
+    writes++;
+    sync(address, 1);
+  }
+
+  void update(int address, uint8_t value)
+  {
+    if (data[address] != value)
+      write(address, value);
+  }
+
+  template <typename T> T& get(int address, T& t)
+  {
+    memcpy((void*) &t, &data[address], sizeof(T));
+
+    return t;
+  }
+
+  template <typename T> const T& put(int address, const T& t)
+  {
+    memcpy(&data[address], (const void*) &t, sizeof(T));
+    writes++;
+    sync(address, sizeof(T));
+
+    return t;
+  }
+
+  void commit()
+  {
+    commits++;
+    memcpy(flash, data, sizeof(data));
+  }
+
+  // Power cycle : what was not committed is lost
+  void reboot()
+  {
+    memcpy(data, flash, sizeof(data));
+  }
+
+#ifdef MOCK_EEPROM_WRITE_THROUGH
+  void sync(int address, int size)    { memcpy(&flash[address], &data[address], size); }
+#else
+  void sync(int, int) {}
+#endif
+};
+
+extern MockEEPROM EEPROM;
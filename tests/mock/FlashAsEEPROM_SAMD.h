@@ -0,0 +1,5 @@
+#pragma once
+
+// Host mock of FlashStorage_SAMD : EEPROM emulated in flash, written by commit()
+
+#include "EEPROM.h"
@@ -0,0 +1,138 @@
+#pragma once
+
+// Host mock of the WiFiNINA TCP client under the MQTT client. Data queued by feed() becomes readable when mock_millis
+// reaches its time, as TCP segments do. Each available() and read() is one SPI transaction to the NINA module
+
+#include "Arduino.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+class MockNetClient : public Client
+{
+  public:
+    struct Segment
+    {
+      unsigned long at;
+      std::string   data;
+    };
+
+    std::deque<Segment> pending;
+    std::string         rx;
+    std::string         tx;
+
+    long availableCalls = 0;
+    long readCalls      = 0;
+    bool isConnected    = true;
+
+    void feed(const std::string& data, unsigned long at = 0)
+    {
+      pending.push_back( { at, data } );
+    }
+
+    long transactions() const
+    {
+      return availableCalls + readCalls;
+    }
+
+    int connect(IPAddress, uint16_t) override           { isConnected = true; return 1; }
+    int connect(const char*, uint16_t) override         { isConnected = true; return 1; }
+    uint8_t connected() override                        { return isConnected || !rx.empty(); }
+    void stop() override                                { isConnected = false; }
+    operator bool() override                            { return isConnected; }
+
+    int available() override
+    {
+      availableCalls++;
+      arrive();
+
+      return rx.size();
+    }
+
+    int read() override
+    {
+      readCalls++;
+      arrive();
+
+      if (rx.empty())
+        return -1;
+
+      int c = (uint8_t) rx[0];
+      rx.erase(0, 1);
+
+      return c;
+    }
+
+    int read(uint8_t* buf, size_t size) override
+    {
+      readCalls++;
+      arrive();
+
+      if (rx.empty())
+        return -1;
+
+      size = std::min(size, rx.size());
+      memcpy(buf, rx.data(), size);
+      rx.erase(0, size);
+
+      return size;
+    }
+
+    int peek() override
+    {
+      arrive();
+
+      return rx.empty() ? -1 : (uint8_t) rx[0];
+    }
+
+    size_t write(uint8_t c) override
+    {
+      tx += (char) c;
+
+      return 1;
+    }
+
+    size_t write(const uint8_t* buf, size_t size) override
+    {
+      tx.append((const char*) buf, size);
+
+      return size;
+    }
+
+  private:
+    void arrive()
+    {
+      while (!pending.empty() && (pending.front().at <= mock_millis))
+      {
+        rx += pending.front().data;
+        pending.pop_front();
+      }
+    }
+};
+
+// MQTT fixed header with the remaining length, and a QoS 0 PUBLISH
+inline std::string mqttFrame(uint8_t type, const std::string& body)
+{
+  std::string frame(1, (char) type);
+  uint32_t    remaining = body.size();
+
+  do
+  {
+    uint8_t b = remaining & 0x7F;
+
+    remaining >>= 7;
+
+    if (remaining)
+      b |= 0x80;
+
+    frame += (char) b;
+  } while (remaining);
+
+  return frame + body;
+}
+
+inline std::string mqttPublish(const std::string& topic, const std::string& data)
+{
+  return mqttFrame(0x30, std::string( { (char) (topic.size() >> 8), (char) topic.size() } ) + topic + data);
+}
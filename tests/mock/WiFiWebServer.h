@@ -0,0 +1,174 @@
+#pragma once
+// Host mock of WiFiNINA_Generic (WiFi, WiFiClient, WiFiServer, WiFiUDP) and WiFiWebServer. Requests and datagrams are
+// injected by the tests, and what the library sends is kept for them to check
+#include "Arduino.h"
+#include <functional>
+#include <vector>
+#include <map>
+#include <deque>
+
+#define WL_IDLE_STATUS 0
+#define WL_NO_SSID_AVAIL 1
+#define WL_CONNECTED 3
+#define WL_CONNECT_FAILED 4
+#define WL_CONNECTION_LOST 5
+#define WL_DISCONNECTED 6
+#define WL_AP_LISTENING 7
+#define WL_AP_CONNECTED 8
+#define WL_NO_MODULE 255
+#define WL_FAILURE 255
+
+struct MockWiFi
+{
+  int st = WL_IDLE_STATUS;
+  int beginCalls = 0;
+  int configCalls = 0;
+  bool connectOK = true;
+  IPAddress ip = IPAddress(192, 168, 2, 99);
+  IPAddress cfgIP, cfgDNS, cfgGW, cfgSN;
+  IPAddress gw = IPAddress(192, 168, 2, 1), sn = IPAddress(255, 255, 255, 0), dns = IPAddress(192, 168, 2, 1);
+  int lowPower = -1;
+  bool pingOK = true; int pingCalls = 0; int endCalls = 0; IPAddress dhcpIP = IPAddress(192, 168, 2, 99);
+  int ping(IPAddress) { pingCalls++; return pingOK ? 5 : -1; }
+  uint8_t status() { return st; }
+  std::string failSSID; std::string lastSSID; IPAddress lastCfgIP;
+  uint8_t begin(const char* ssid, const char* pass) { beginCalls++; mock_delay(); lastSSID = ssid; lastCfgIP = cfgIP; ip = (cfgIP == IPAddress(0,0,0,0)) ? dhcpIP : cfgIP; st = (connectOK && failSSID != ssid) ? WL_CONNECTED : WL_CONNECT_FAILED; return st; }
+  uint8_t begin(const char* ssid) { return begin(ssid, ""); }
+  uint8_t beginAP(const char*, const char*, uint8_t) { st = WL_AP_LISTENING; return st; }
+  uint8_t beginAP(const char*, uint8_t) { st = WL_AP_LISTENING; return st; }
+  void config(IPAddress a) { configCalls++; cfgIP = a; }
+  void config(IPAddress a, IPAddress d) { configCalls++; cfgIP = a; cfgDNS = d; }
+  void config(IPAddress a, IPAddress d, IPAddress g) { configCalls++; cfgIP = a; cfgDNS = d; cfgGW = g; }
+  void config(IPAddress a, IPAddress d, IPAddress g, IPAddress s) { configCalls++; cfgIP = a; cfgDNS = d; cfgGW = g; cfgSN = s; }
+  void setDNS(IPAddress d) { cfgDNS = d; }
+  void setDNS(IPAddress d, IPAddress) { cfgDNS = d; }
+  void end() { st = WL_IDLE_STATUS; endCalls++; cfgIP = cfgDNS = cfgGW = cfgSN = IPAddress(0,0,0,0); }
+  void disconnect() { st = WL_DISCONNECTED; }
+  void setHostname(const char*) {}
+  void hostname(const char*) {}
+  IPAddress localIP() { return ip; }
+  IPAddress gatewayIP() { return gw; }
+  IPAddress subnetMask() { return sn; }
+  IPAddress dnsIP(int = 0) { return dns; }
+  const char* SSID() { return "mockssid"; }
+  const char* SSID(uint8_t i) { static char b[16]; snprintf(b, sizeof b, "net%u", i); return b; }
+  int32_t RSSI() { return -60; }
+  int32_t RSSI(uint8_t i) { return -40 - i * 5; }
+  uint8_t encryptionType(uint8_t) { return 4; }
+  int8_t scanNetworks() { return 3; }
+  uint8_t mac[6] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x00, 0x01 };
+  uint8_t* macAddress(uint8_t* m) { memcpy(m, mac, 6); return m; }
+  void lowPowerMode() { lowPower = 1; }
+  void noLowPowerMode() { lowPower = 0; }
+  unsigned long beginMs = 0;
+  void mock_delay() { mock_millis += beginMs; }
+};
+extern MockWiFi WiFi;
+
+// Simple mock socket with in/out buffers
+class WiFiClient : public Client
+{
+  public:
+    struct Sock { std::string in, out; bool open = true; bool closedByServer = false; int id; };
+    Sock* sock = nullptr;
+    WiFiClient() {}
+    WiFiClient(Sock* s) : sock(s) {}
+    int connect(IPAddress, uint16_t) override { return 1; }
+    int connect(const char*, uint16_t) override { return 1; }
+    uint8_t connected() override { return sock && (sock->open || !sock->in.empty()); }
+    void stop() override { if (sock) { sock->open = false; sock->closedByServer = true; } sock = nullptr; }
+    int available() override { return sock ? sock->in.size() : 0; }
+    int read() override { if (!sock || sock->in.empty()) return -1; int c = (uint8_t) sock->in[0]; sock->in.erase(0, 1); return c; }
+    int read(uint8_t* b, size_t n) override { if (!sock) return -1; size_t k = std::min(n, sock->in.size()); memcpy(b, sock->in.data(), k); sock->in.erase(0, k); return k; }
+    int peek() override { return (sock && !sock->in.empty()) ? (uint8_t) sock->in[0] : -1; }
+    size_t write(uint8_t c) override { if (!sock) return 0; sock->out += (char) c; writeCalls++; return 1; }
+    size_t write(const uint8_t* b, size_t n) override { if (!sock) return 0; sock->out.append((const char*) b, n); writeCalls++; return n; }
+    using Print::write;
+    operator bool() override { return sock != nullptr; }
+    bool operator==(const WiFiClient& o) const { return sock == o.sock; }
+    bool operator!=(const WiFiClient& o) const { return sock != o.sock; }
+    IPAddress remoteIP() { return IPAddress(192, 168, 4, 2); }
+    uint16_t remotePort() { return sock ? 40000 + sock->id : 0; }
+    static int writeCalls;
+};
+
+class WiFiServer
+{
+  public:
+    static std::deque<WiFiClient::Sock*> pending;
+    static std::vector<WiFiClient::Sock*> all;
+    uint16_t port;
+    WiFiServer(uint16_t p) : port(p) {}
+    void begin() {}
+    // NINA returns a client that has data available
+    WiFiClient available() { for (auto* s : all) if (s->open && !s->in.empty()) return WiFiClient(s); return WiFiClient(); }
+};
+
+// Datagrams to receive are queued in rx, those sent are kept in sent
+class WiFiUDP
+{
+  public:
+    std::deque<std::string> rx; std::string cur, tx; std::vector<std::string> sent; IPAddress rip; uint16_t rport = 0;
+    uint8_t begin(uint16_t) { return 1; }
+    void stop() {}
+    int parsePacket() { if (rx.empty()) return 0; cur = rx.front(); rx.pop_front(); rip = IPAddress(192, 168, 4, 2); rport = 5353; return cur.size(); }
+    int available() { return cur.size(); }
+    int read(uint8_t* b, size_t n) { size_t k = std::min(n, cur.size()); memcpy(b, cur.data(), k); cur.erase(0, k); return k; }
+    int read(char* b, size_t n) { return read((uint8_t*) b, n); }
+    int beginPacket(IPAddress, uint16_t) { tx.clear(); return 1; }
+    size_t write(const uint8_t* b, size_t n) { tx.append((const char*) b, n); return n; }
+    size_t write(uint8_t c) { tx += (char) c; return 1; }
+    int endPacket() { sent.push_back(tx); return 1; }
+    void flush() { cur.clear(); }
+    IPAddress remoteIP() { return rip; }
+    uint16_t remotePort() { return rport; }
+};
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+// Mock of khoih-prog WiFiWebServer API subset, request is injected directly
+class WiFiWebServer
+{
+  public:
+    typedef std::function<void(void)> THandlerFunction;
+    WiFiWebServer(int port = 80) {}
+    void begin() {}
+    void on(const String& uri, THandlerFunction h) { handlers[uri.s] = h; }
+    void on(const String& uri, HTTPMethod, THandlerFunction h) { handlers[uri.s] = h; }
+    void onNotFound(THandlerFunction h) { notFound = h; }
+    void handleClient() {}
+    String arg(const String& name) { for (auto& a : args) if (a.first == name.s) return String(a.second); return String(); }
+    String arg(int i) { return String(args[i].second); }
+    String argName(int i) { return String(args[i].first); }
+    int args_() { return args.size(); }
+    bool hasArg(const String& name) { for (auto& a : args) if (a.first == name.s) return true; return false; }
+    String uri() { return String(curUri); }
+    HTTPMethod method() { return curMethod; }
+    String hostHeader() { return String("192.168.4.1"); }
+    void sendHeader(const String& n, const String& v, bool = false) { headers += n.s + ": " + v.s + "\n"; }
+    void setContentLength(size_t l) { contentLength = l; }
+    void send(int code, const char* type, const String& content) { lastCode = code; lastType = type; response = content.s; sends++; }
+    void send(int code, const String& type, const String& content) { send(code, type.c_str(), content); }
+    void send_P(int code, const char* type, const char* content, size_t n) { lastCode = code; lastType = type; response.assign(content, n); sends++; }
+    void send(int code) { lastCode = code; response.clear(); sends++; }
+    void sendContent(const String& c) { response += c.s; contentWrites++; }
+    void sendContent(const char* c, size_t n) { response.append(c, n); contentWrites++; }
+    WiFiClient client() { return cl; }
+    // test helpers
+    void request(const std::string& uri, std::vector<std::pair<std::string, std::string>> a, HTTPMethod m = HTTP_GET)
+    {
+      curUri = uri; args = a; curMethod = m; headers.clear(); response.clear(); contentLength = CONTENT_LENGTH_UNKNOWN; lastCode = 0;
+      auto it = handlers.find(uri);
+      if (it != handlers.end()) it->second(); else if (notFound) notFound(); else lastCode = 404;
+    }
+    std::map<std::string, THandlerFunction> handlers;
+    THandlerFunction notFound;
+    std::vector<std::pair<std::string, std::string>> args;
+    std::string curUri, headers, response, lastType;
+    HTTPMethod curMethod = HTTP_GET;
+    int lastCode = 0, sends = 0, contentWrites = 0;
+    size_t contentLength = CONTENT_LENGTH_UNKNOWN;
+    WiFiClient cl;
+};
@@ -0,0 +1,61 @@
+/*********************************************************************************************************************************
+  test.h
+  For the host tests of WiFiManager_NINA_Lite
+
+  Checks, and the globals of the mocks. Include once, in the file with main(), before the library headers.
+  **********************************************************************************************************************************/
+
+#pragma once
+
+#include "Arduino.h"
+#include "WiFiWebServer.h"
+#include "EEPROM.h"
+#include "DoubleResetDetector_Generic.h"
+
+unsigned long                   mock_millis = 1;
+MockSerial                      Serial;
+MockWiFi                        WiFi;
+MockWDT                         mockWDT;
+MockEEPROM                      EEPROM;
+
+bool                            DoubleResetDetector_Generic::mock_drd = false;
+
+int                             WiFiClient::writeCalls = 0;
+std::deque<WiFiClient::Sock*>   WiFiServer::pending;
+std::vector<WiFiClient::Sock*>  WiFiServer::all;
+
+static int testChecks   = 0;
+static int testFailures = 0;
+
+#define CHECK(condition)                                                                          \
+  do                                                                                              \
+  {                                                                                               \
+    testChecks++;                                                                                 \
+    if (!(condition))                                                                             \
+    {                                                                                             \
+      testFailures++;                                                                             \
+      printf("FAIL %s:%d : %s\n", __FILE__, __LINE__, #condition);                                \
+    }                                                                                             \
+  } while (0)
+
+// Integers only. Both values are printed on failure
+#define CHECK_EQUAL(actual, expected)                                                             \
+  do                                                                                              \
+  {                                                                                               \
+    long long actual_   = (long long) (actual);                                                   \
+    long long expected_ = (long long) (expected);                                                 \
+    testChecks++;                                                                                 \
+    if (actual_ != expected_)                                                                     \
+    {                                                                                             \
+      testFailures++;                                                                             \
+      printf("FAIL %s:%d : %s is %lld, not %lld\n", __FILE__, __LINE__, #actual, actual_, expected_); \
+    }                                                                                             \
+  } while (0)
+
+// Return value of main()
+inline int testResult(const char* name)
+{
+  printf("%-24s %d checks, %d failed\n", name, testChecks, testFailures);
+
+  return testFailures ? 1 : 0;
+}
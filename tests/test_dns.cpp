@@ -0,0 +1,141 @@
+/*********************************************************************************************************************************
+  test_dns.cpp
+  For the host tests of WiFiManager_NINA_Lite
+
+  WiFiNINA_DNSServer : answers, dropped queries and the budget of each processRequests()
+  **********************************************************************************************************************************/
+
+#include "test.h"
+
+#define USE_CAPTIVE_PORTAL_DNS      true
+
+#define private public
+#include <WiFiManager_NINA_Lite_Debug.h>
+#include <WiFiManager_NINA_Lite_PortalServer.h>
+#include <WiFiManager_NINA_Lite_DNSServer.h>
+#undef private
+
+#include <vector>
+
+// Standard query, RD set, with an EDNS OPT record in the additional section
+static std::string query(uint16_t id, const char* name, uint16_t type)
+{
+  std::string q = { (char) (id >> 8), (char) id, 0x01, 0x00, 0, 1, 0, 0, 0, 0, 0, 1 };
+
+  for (const char* p = name; *p; )
+  {
+    const char* dot = strchr(p, '.');
+    size_t      len = dot ? dot - p : strlen(p);
+
+    q += (char) len;
+    q.append(p, len);
+    p += len + (dot ? 1 : 0);
+  }
+
+  q += std::string("\0", 1) + (char) (type >> 8) + (char) type + std::string("\0\1", 2);
+  q += std::string("\0\0\x29\x10\0\0\0\0\0\0\0", 11);
+
+  return q;
+}
+
+static uint8_t at(const std::string& s, size_t i)
+{
+  return (uint8_t) s[i];
+}
+
+int main()
+{
+  WiFiNINA_DNSServer dns;
+
+  dns.start(IPAddress(192, 168, 4, 1));
+
+  // A : one answer pointing to the question name, the AP IP, TTL WM_DNS_TTL. EDNS record dropped
+  std::string q = query(0x1234, "captive.apple.com", WM_DNS_TYPE_A);
+  size_t      questionEnd = q.size() - 11;
+
+  dns.udp.rx.push_back(q);
+  dns.processRequests();
+
+  CHECK_EQUAL(dns.udp.sent.size(), 1);
+
+  std::string r = dns.udp.sent.back();
+
+  CHECK_EQUAL(r.size(), questionEnd + WM_DNS_ANSWER_SIZE);
+  CHECK_EQUAL( (at(r, 0) << 8) | at(r, 1), 0x1234);
+  CHECK_EQUAL(at(r, 2), 0x85);                  // QR, AA, RD
+  CHECK_EQUAL(at(r, 3), 0x00);                  // NOERROR
+  CHECK_EQUAL(at(r, 5), 1);                     // QDCOUNT
+  CHECK_EQUAL(at(r, 7), 1);                     // ANCOUNT
+  CHECK_EQUAL(at(r, 11), 0);                    // ARCOUNT
+  CHECK(r.compare(WM_DNS_HEADER_SIZE, questionEnd - WM_DNS_HEADER_SIZE, q, WM_DNS_HEADER_SIZE, questionEnd - WM_DNS_HEADER_SIZE) == 0);
+  CHECK_EQUAL(at(r, questionEnd), 0xC0);
+  CHECK_EQUAL(at(r, questionEnd + 1), WM_DNS_HEADER_SIZE);
+  CHECK_EQUAL(at(r, questionEnd + 9), WM_DNS_TTL);
+  CHECK_EQUAL(at(r, questionEnd + 11), 4);
+  CHECK(r.compare(r.size() - 4, 4, "\xC0\xA8\x04\x01") == 0);
+
+  // ANY is answered as A
+  dns.udp.rx.push_back(query(2, "example.org", WM_DNS_TYPE_ANY));
+  dns.processRequests();
+
+  CHECK_EQUAL(dns.udp.sent.size(), 2);
+  CHECK_EQUAL(at(dns.udp.sent.back(), 7), 1);
+
+  // AAAA : empty NOERROR answer, so that the client doesn't wait for it
+  dns.udp.rx.push_back(query(3, "connectivitycheck.gstatic.com", 28));
+  dns.processRequests();
+
+  CHECK_EQUAL(dns.udp.sent.size(), 3);
+  CHECK_EQUAL(at(dns.udp.sent.back(), 3), 0x00);
+  CHECK_EQUAL(at(dns.udp.sent.back(), 7), 0);
+  CHECK_EQUAL(dns.udp.sent.back().size(), query(3, "connectivitycheck.gstatic.com", 28).size() - 11);
+
+  // Dropped : response, non-standard opcode, compression pointer in the question, truncated question, too short,
+  // no question, too large for the buffer
+  std::string response  = query(4, "a.b", WM_DNS_TYPE_A);
+  std::string opcode    = response;
+  std::string pointer   = std::string(response, 0, WM_DNS_HEADER_SIZE) + std::string("\xC0\x0C\0\1\0\1", 6);
+  std::string truncated = std::string(response, 0, response.size() - 11 - 2);
+  std::string noQuery   = response;
+  std::string large     = query(5, (std::string(60, 'a') + "." + std::string(60, 'b')).c_str(), WM_DNS_TYPE_A);
+
+  response[2] |= 0x80;
+  opcode[2]   |= 0x10;
+  noQuery[5]   = 0;
+
+  for (const std::string& bad : { response, opcode, pointer, truncated, std::string(response, 0, 8), noQuery, large })
+    dns.udp.rx.push_back(bad);
+
+  dns.udp.rx.push_back(query(6, "after.bad", WM_DNS_TYPE_A));
+
+  for (int i = 0; i < 4; i++)
+    dns.processRequests();
+
+  CHECK_EQUAL(dns.udp.sent.size(), 4);
+  CHECK_EQUAL(at(dns.udp.sent.back(), 1), 6);
+
+  // At most WM_DNS_MAX_PACKETS_PER_CALL queries per call, the others are left for the next call
+  for (int i = 0; i < WM_DNS_MAX_PACKETS_PER_CALL + 2; i++)
+    dns.udp.rx.push_back(query(100 + i, "burst.local", WM_DNS_TYPE_A));
+
+  dns.processRequests();
+
+  CHECK_EQUAL(dns.udp.sent.size(), 4 + WM_DNS_MAX_PACKETS_PER_CALL);
+  CHECK_EQUAL(dns.udp.rx.size(), 2);
+
+  dns.processRequests();
+
+  CHECK_EQUAL(dns.udp.sent.size(), 4 + WM_DNS_MAX_PACKETS_PER_CALL + 2);
+  CHECK_EQUAL(at(dns.udp.sent.back(), 1), 100 + WM_DNS_MAX_PACKETS_PER_CALL + 1);
+
+  // Unknown pages are redirected to the portal
+  WiFiWebServer server;
+
+  server.onNotFound([&server]() { WiFiNINA_redirectToPortal(&server, IPAddress(192, 168, 4, 1)); });
+  server.request("/generate_204", {});
+
+  CHECK_EQUAL(server.lastCode, 302);
+  CHECK(server.headers.find("Location: http://192.168.4.1/\n") != std::string::npos);
+
+  return testResult("test_dns");
+}
@@ -0,0 +1,144 @@
+/*********************************************************************************************************************************
+  test_json.cpp
+  For the host tests of WiFiManager_NINA_Lite
+
+  /config.json of the SAMD board header : export, rejected documents leaving the config unchanged, a saved document kept
+  after a reboot, and 409 while a saved config waits for reconfigure()
+  **********************************************************************************************************************************/
+
+#define ARDUINO_SAMD_ZERO
+
+#include "test.h"
+
+#define USE_DYNAMIC_PARAMETERS      true
+#define USE_JSON_CONFIG_API         true
+#define USE_LIVE_RECONFIG           true
+#define EEPROM_SIZE                 4096
+#define EEPROM_START                0
+
+#define private public
+#include <WiFiManager_NINA_Lite_SAMD.h>
+#undef private
+
+char      AIO_SERVER[21]  = "io.adafruit.com";
+uint16_t  PORT            = 1883;
+bool      FLAG            = true;
+uint8_t   MODE            = 1;
+float     RATIO           = 1.5;
+
+MenuItem myMenuItems [] =
+{
+  { "svr", "AIO_SERVER",  AIO_SERVER,       20 },
+  { "prt", "PORT",        (char*) &PORT,    sizeof(PORT),   WM_ITEM_UINT16 },
+  { "flg", "FLAG",        (char*) &FLAG,    sizeof(FLAG),   WM_ITEM_BOOL },
+  { "mod", "MODE",        (char*) &MODE,    sizeof(MODE),   WM_ITEM_ENUM,   "off|low|high" },
+  { "rat", "RATIO",       (char*) &RATIO,   sizeof(RATIO),  WM_ITEM_FLOAT },
+};
+
+uint16_t NUM_MENU_ITEMS = sizeof(myMenuItems) / sizeof(MenuItem);
+
+bool LOAD_DEFAULT_CONFIG_DATA = false;
+
+WiFiNINA_Configuration defaultConfig;
+
+static void post(WiFiWebServer* server, const char* document)
+{
+  server->request("/config.json", { { "plain", document } }, HTTP_POST);
+}
+
+int main()
+{
+  Serial.quiet = true;
+
+  WiFiManager_NINA_Lite* wm = new WiFiManager_NINA_Lite();
+  wm->begin("host");
+
+  WiFiWebServer* server = wm->server;
+
+  server->request("/config.json", {});
+
+  CHECK_EQUAL(server->lastCode, 200);
+  CHECK(server->response == "{\"id\":\"blank\",\"pw\":\"blank\",\"id1\":\"blank\",\"pw1\":\"blank\",\"nm\":\"blank\","
+                            "\"svr\":\"blank\",\"prt\":0,\"flg\":false,\"mod\":\"off\",\"rat\":0}");
+
+  // Rejected as a whole, naming the first bad key
+  struct
+  {
+    const char* document;
+    const char* response;
+  } bad [] =
+  {
+    { "{\"id\":\"x\",\"zzz\":1}",                           "{\"error\":\"invalid\",\"key\":\"zzz\"}" },
+    { "{\"prt\":70000}",                                    "{\"error\":\"invalid\",\"key\":\"prt\"}" },
+    { "{\"id\":\"0123456789012345678901234567890123\"}",    "{\"error\":\"invalid\",\"key\":\"id\"}" },
+    { "{\"svr\":\"a\",}",                                   "{\"error\":\"syntax\",\"key\":\"\"}" },
+    { "{\"mod\":\"medium\"}",                               "{\"error\":\"invalid\",\"key\":\"mod\"}" },
+    { "{\"id\":\"a\\q\"}",                                  "{\"error\":\"invalid\",\"key\":\"id\"}" },
+    { "[1]",                                                "{\"error\":\"syntax\",\"key\":\"\"}" },
+    { "{\"svr\":null}",                                     "{\"error\":\"invalid\",\"key\":\"svr\"}" },
+    { "{\"svr\":\"abc",                                     "{\"error\":\"invalid\",\"key\":\"svr\"}" },
+  };
+
+  int commits = EEPROM.commits;
+
+  for (auto& b : bad)
+  {
+    post(server, b.document);
+
+    CHECK_EQUAL(server->lastCode, 400);
+
+    if (server->response != b.response)
+    {
+      CHECK(!"response");
+      printf("  %s -> %s\n", b.document, server->response.c_str());
+    }
+  }
+
+  CHECK(strcmp(AIO_SERVER, "blank") == 0);
+  CHECK_EQUAL(PORT, 0);
+  CHECK_EQUAL(EEPROM.commits, commits);
+
+  // Escapes, \u, whitespace and all the item types
+  post(server, " {\"id\":\"ssid \\\"0\\\"\", \"pw\":\"password0\",\"id1\":\"ssid1\",\"pw1\":\"password1\",\"nm\":\"caf\\u00e9\",\n"
+               " \"svr\":\"broker.local\",\"prt\":8883,\"flg\":false,\"mod\":\"high\",\"rat\":-0.25 } ");
+
+  CHECK_EQUAL(server->lastCode, 200);
+  CHECK(server->response == "{\"saved\":true}");
+  CHECK(EEPROM.commits > commits);
+
+  // Not applied yet : another POST would be lost by reconfigure()
+  post(server, "{\"svr\":\"other\"}");
+
+  CHECK_EQUAL(server->lastCode, 409);
+  CHECK(server->response == "{\"error\":\"pending\",\"key\":\"\"}");
+  CHECK(strcmp(AIO_SERVER, "broker.local") == 0);
+
+  server->request("/config.json", {});
+
+  CHECK_EQUAL(server->lastCode, 200);
+
+  // Loaded again after a reboot
+  EEPROM.reboot();
+
+  strcpy(AIO_SERVER, "x");
+  PORT = 0;
+  MODE = 0;
+
+  WiFiManager_NINA_Lite* wm2 = new WiFiManager_NINA_Lite();
+  wm2->begin("host");
+
+  CHECK(wm2->getWiFiSSID(0) == "ssid \"0\"");
+  CHECK(strcmp(wm2->WIFININA_config.board_name, "caf\xC3\xA9") == 0);
+  CHECK(strcmp(AIO_SERVER, "broker.local") == 0);
+  CHECK_EQUAL(PORT, 8883);
+  CHECK_EQUAL(FLAG, false);
+  CHECK_EQUAL(MODE, 2);
+  CHECK(RATIO == -0.25f);
+  CHECK(!wm2->configuration_mode);
+
+  CHECK(WiFiNINA_configToJson(wm2->WIFININA_config) ==
+        "{\"id\":\"ssid \\\"0\\\"\",\"pw\":\"password0\",\"id1\":\"ssid1\",\"pw1\":\"password1\",\"nm\":\"caf\xC3\xA9\","
+        "\"svr\":\"broker.local\",\"prt\":8883,\"flg\":false,\"mod\":\"high\",\"rat\":-0.25}");
+
+  return testResult("test_json");
+}
@@ -0,0 +1,88 @@
+/*********************************************************************************************************************************
+  test_mqtt_dispatch.cpp
+  For the host tests of WiFiManager_NINA_Lite
+
+  WiFiNINA_MQTT_Client::processPackets() : callbacks without waiting, and the packets handled by each call under a flood
+  **********************************************************************************************************************************/
+
+#include "test.h"
+#include "MockNetClient.h"
+
+#include "Adafruit_MQTT_Client.h"
+#include <WiFiManager_NINA_Lite_MQTT.h>
+
+static int         callbacks = 0;
+static std::string lastValue;
+
+static void onMessage(char* data, uint16_t len)
+{
+  callbacks++;
+  lastValue.assign(data, len);
+}
+
+int main()
+{
+  MockNetClient        net;
+  WiFiNINA_MQTT_Client mqtt(&net, "broker", 1883, "user", "pass");
+
+  Adafruit_MQTT_Subscribe sub(&mqtt, "t/x");
+  sub.setCallback(onMessage);
+  mqtt.subscribe(&sub);
+
+  // Messages and a stray PUBACK already received : all dispatched at once, nothing sent, no time waited
+  std::string five;
+
+  for (int i = 0; i < 5; i++)
+    five += mqttPublish("t/x", "x" + std::to_string(i));
+
+  net.feed(five + std::string("\x40\x02\x00\x09", 4), 1);
+
+  unsigned long start = mock_millis;
+
+  mqtt.processPackets(0);
+
+  CHECK_EQUAL(callbacks, 5);
+  CHECK(lastValue == "x4");
+  CHECK_EQUAL(mock_millis - start, 0);
+  CHECK_EQUAL(net.tx.size(), 0);
+
+  // 1000 messages at once : WM_MQTT_MAX_PACKETS_PER_CALL per call, so that run() keeps its other work going
+  std::string flood;
+
+  for (int i = 0; i < 1000; i++)
+    flood += mqttPublish("t/x", "1");
+
+  net.feed(flood, mock_millis);
+  callbacks = 0;
+
+  int calls = 0;
+
+  while ( (callbacks < 1000) && (calls < 500) )
+  {
+    int before = callbacks;
+
+    start = mock_millis;
+    mqtt.processPackets(0);
+    calls++;
+
+    if (calls == 1)
+    {
+      CHECK_EQUAL(callbacks - before, WM_MQTT_MAX_PACKETS_PER_CALL);
+      CHECK_EQUAL(mock_millis - start, 0);
+    }
+  }
+
+  CHECK_EQUAL(WM_MQTT_MAX_PACKETS_PER_CALL, 16);
+  CHECK_EQUAL(callbacks, 1000);
+  CHECK_EQUAL(calls, 63);
+
+  // Nothing left
+  callbacks = 0;
+  start     = mock_millis;
+  mqtt.processPackets(0);
+
+  CHECK_EQUAL(callbacks, 0);
+  CHECK_EQUAL(mock_millis - start, 0);
+
+  return testResult("test_mqtt_dispatch");
+}
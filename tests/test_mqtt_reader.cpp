@@ -0,0 +1,156 @@
+/*********************************************************************************************************************************
+  test_mqtt_reader.cpp
+  For the host tests of WiFiManager_NINA_Lite
+
+  WiFiNINA_MQTT_Client receive buffer : packets in order, whether coalesced or fragmented, the SPI transactions they take,
+  one available() per processPackets() and oversize packets skipped without blocking
+  **********************************************************************************************************************************/
+
+#include "test.h"
+#include "MockNetClient.h"
+
+#include "Adafruit_MQTT_Client.h"
+#include <WiFiManager_NINA_Lite_MQTT.h>
+
+#include <vector>
+
+struct Result
+{
+  int   messages;
+  int   inOrder;
+  bool  afterOversize;
+  long  transactions;
+};
+
+// 50 messages, then one larger than MAXBUFFERSIZE and one more, read by readSubscription()
+template <class MQTT_Client>
+static Result readAll(bool fragmented)
+{
+  MockNetClient net;
+  MQTT_Client   mqtt(&net, "broker", 1883, "user", "pass");
+  Result        result = { 0, 0, false, 0 };
+
+  Adafruit_MQTT_Subscribe sub(&mqtt, "t/led");
+  mqtt.subscribe(&sub);
+
+  std::string all;
+
+  for (int i = 0; i < 50; i++)
+    all += mqttPublish("t/led", "v" + std::to_string(i));
+
+  all += mqttPublish("t/big", std::string(300, 'x'));
+  all += mqttPublish("t/led", "after-big");
+
+  mock_millis = 1;
+
+  if (fragmented)
+  {
+    // 1 byte segments, 3 per ms
+    for (size_t i = 0; i < all.size(); i++)
+      net.feed(all.substr(i, 1), 1 + i / 3);
+  }
+  else
+    net.feed(all, 1);
+
+  for (int idle = 0; idle <= 2; )
+  {
+    Adafruit_MQTT_Subscribe* s = mqtt.readSubscription(100);
+
+    if (!s)
+    {
+      idle++;
+      continue;
+    }
+
+    idle = 0;
+
+    std::string value = (char*) s->lastread;
+
+    if (value == "v" + std::to_string(result.messages))
+      result.inOrder++;
+
+    result.afterOversize = (value == "after-big");
+    result.messages++;
+  }
+
+  result.transactions = net.transactions();
+
+  return result;
+}
+
+static std::vector<std::string> received;
+
+static void onMessage(char* data, uint16_t len)
+{
+  received.emplace_back(data, len);
+}
+
+int main()
+{
+  // Same messages as Adafruit_MQTT_Client, in a few bulk reads instead of available() and read() for each byte
+  Result stock     = readAll<Adafruit_MQTT_Client>(false);
+  Result coalesced = readAll<WiFiNINA_MQTT_Client>(false);
+  Result fragments = readAll<WiFiNINA_MQTT_Client>(true);
+
+  CHECK_EQUAL(stock.messages, 51);
+  CHECK_EQUAL(stock.transactions, 1869);
+
+  CHECK_EQUAL(coalesced.messages, 51);
+  CHECK_EQUAL(coalesced.inOrder, 50);
+  CHECK(coalesced.afterOversize);
+  CHECK_EQUAL(coalesced.transactions, 44);
+
+  CHECK_EQUAL(fragments.messages, 51);
+  CHECK_EQUAL(fragments.inOrder, 50);
+  CHECK(fragments.afterOversize);
+  CHECK_EQUAL(fragments.transactions, 131);
+
+  MockNetClient        net;
+  WiFiNINA_MQTT_Client mqtt(&net, "broker", 1883, "user", "pass");
+
+  Adafruit_MQTT_Subscribe sub(&mqtt, "t/a");
+  sub.setCallback(onMessage);
+  mqtt.subscribe(&sub);
+
+  // Packets already buffered : one available() for the whole processPackets()
+  std::string ten;
+
+  for (int i = 0; i < 10; i++)
+    ten += mqttPublish("t/a", "v" + std::to_string(i));
+
+  mock_millis = 1;
+  net.feed(ten, 1);
+
+  long available = net.availableCalls;
+
+  mqtt.processPackets(0);
+
+  CHECK_EQUAL(received.size(), 10);
+  CHECK_EQUAL(net.availableCalls - available, 1);
+
+  // 2000 bytes message arriving in 100 bytes segments, 10 ms apart, then a short one. The oversize one is skipped over
+  // several calls, none of them waiting for the rest of it
+  std::string big = mqttPublish("t/a", std::string(2000, 'x')) + mqttPublish("t/a", "after");
+
+  for (size_t i = 0; i < big.size(); i += 100)
+    net.feed(big.substr(i, 100), 100 + i / 10);
+
+  received.clear();
+
+  unsigned long longestCall = 0;
+
+  for (mock_millis = 1; mock_millis < 400; mock_millis++)
+  {
+    unsigned long start = mock_millis;
+
+    mqtt.processPackets(0);
+    longestCall = std::max(longestCall, mock_millis - start);
+  }
+
+  CHECK_EQUAL(longestCall, 0);
+  CHECK_EQUAL(received.size(), 2);
+  CHECK_EQUAL(received.front().size(), 99);
+  CHECK(received.back() == "after");
+
+  return testResult("test_mqtt_reader");
+}
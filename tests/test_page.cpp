@@ -0,0 +1,156 @@
+/*********************************************************************************************************************************
+  test_page.cpp
+  For the host tests of WiFiManager_NINA_Lite
+
+  WiFiNINA_PageWriter : the counting pass gives the bytes the writing pass sends, so that the portal page of the SAMD
+  header is sent with its exact Content-Length, in WM_PAGE_BUFFER_SIZE writes
+  **********************************************************************************************************************************/
+
+#define ARDUINO_SAMD_ZERO
+
+#include "test.h"
+
+#define USE_DYNAMIC_PARAMETERS      true
+#define USE_STATIC_IP_CONFIG        true
+#define USE_PAGE_STREAMING          true
+#define EEPROM_SIZE                 4096
+#define EEPROM_START                0
+
+#define private public
+#include <WiFiManager_NINA_Lite_SAMD.h>
+#undef private
+
+char AIO_SERVER[21]   = "io.adafruit.com";
+char AIO_PORT[6]      = "1883";
+char AIO_USERNAME[20] = "user";
+char AIO_KEY[40]      = "0123456789abcdef";
+
+MenuItem myMenuItems [] =
+{
+  { "svr", "AIO_SERVER",    AIO_SERVER,   20 },
+  { "prt", "AIO_PORT",      AIO_PORT,     5 },
+  { "usr", "AIO_USERNAME",  AIO_USERNAME, 19 },
+  { "key", "AIO_KEY",       AIO_KEY,      39 },
+};
+
+uint16_t NUM_MENU_ITEMS = sizeof(myMenuItems) / sizeof(MenuItem);
+
+bool LOAD_DEFAULT_CONFIG_DATA = false;
+
+WiFiNINA_Configuration defaultConfig;
+
+static bool has(const std::string& page, const char* text)
+{
+  return page.find(text) != std::string::npos;
+}
+
+// Tokens replaced by value(), name token, and text larger than the buffer, written to client or only counted
+static size_t writeSample(WiFiNINA_PageWriter& page)
+{
+  static const std::string large(WM_PAGE_BUFFER_SIZE + 100, 'x');
+
+  page.setName("BOARD", "my-board");
+  page.expand("<p>[[id]] {v} [[none]] BOARD</p>", [](WiFiNINA_PageWriter& out, const char* token, size_t len)
+  {
+    if (len == 3)
+    {
+      out.print("value");
+      return true;
+    }
+
+    if (strncmp(token, "[[id]]", len) == 0)
+    {
+      out.print(String("ssid"));
+      return true;
+    }
+
+    return false;
+  });
+
+  page.print(large.c_str());
+  page.write("end", 3);
+
+  return page.length();
+}
+
+int main()
+{
+  Serial.quiet = true;
+
+  // Counting pass and writing pass agree, in 3 client writes : buffered text, the large text, the rest
+  WiFiNINA_PageWriter counter;
+  WiFiClient::Sock    sock;
+  WiFiClient          client(&sock);
+  WiFiNINA_PageWriter writer(&client);
+
+  size_t counted = writeSample(counter);
+
+  WiFiClient::writeCalls = 0;
+
+  size_t written = writeSample(writer);
+
+  CHECK(writer.flush());
+  CHECK_EQUAL(counted, written);
+  CHECK_EQUAL(sock.out.size(), counted);
+  CHECK_EQUAL(WiFiClient::writeCalls, 3);
+  CHECK(sock.out.compare(0, 40, "<p>ssid value [[none]] my-board</p>xxxxx") == 0);
+
+  // A closed client fails the writer, which stops sending
+  WiFiClient          closed;
+  WiFiNINA_PageWriter failing(&closed);
+
+  writeSample(failing);
+
+  CHECK(!failing.flush());
+
+  // Portal page, without then with a saved config. Content-Length from the counting pass is what the client gets
+  WiFiManager_NINA_Lite* wm = new WiFiManager_NINA_Lite();
+  wm->begin("host");
+
+  WiFiWebServer* server = wm->server;
+
+  server->cl.sock = &sock;
+
+  size_t pageSize [2] = { 1349, 1386 };
+
+  for (int withConfig = 0; withConfig < 2; withConfig++)
+  {
+    if (withConfig)
+    {
+      wm->hadConfigData = true;
+
+      strcpy(wm->WIFININA_config.WiFi_Creds[0].wifi_ssid, "HueNet1");
+      strcpy(wm->WIFININA_config.WiFi_Creds[0].wifi_pw,   "12345678");
+      strcpy(wm->WIFININA_config.WiFi_Creds[1].wifi_ssid, "HueNet2");
+      strcpy(wm->WIFININA_config.WiFi_Creds[1].wifi_pw,   "password2");
+      strcpy(wm->WIFININA_config.board_name, "my-board");
+
+      uint8_t ip[4] = { 192, 168, 2, 50 };
+      memcpy(wm->WIFININA_config.staticIP.ip, ip, sizeof(ip));
+    }
+
+    sock.out.clear();
+    WiFiClient::writeCalls = 0;
+
+    server->request("/", {});
+
+    CHECK_EQUAL(server->lastCode, 200);
+    CHECK_EQUAL(server->contentLength, sock.out.size());
+    CHECK_EQUAL(sock.out.size(), pageSize[withConfig]);
+    CHECK_EQUAL(WiFiClient::writeCalls, (pageSize[withConfig] + WM_PAGE_BUFFER_SIZE - 1) / WM_PAGE_BUFFER_SIZE);
+    CHECK(sock.out.compare(0, 15, "<!DOCTYPE html>") == 0);
+    CHECK(sock.out.compare(sock.out.size() - 7, 7, "</html>") == 0);
+    CHECK(has(sock.out, "<title>host</title>"));
+    CHECK(has(sock.out, "value='blank' id='svr'"));
+    CHECK(!has(sock.out, "[["));
+
+    if (withConfig)
+    {
+      CHECK(has(sock.out, "value='password2' id='pw1'"));
+      CHECK(has(sock.out, "value='my-board' id='nm'"));
+      CHECK(has(sock.out, "value='192.168.2.50' id='ip'"));
+    }
+  }
+
+  return testResult("test_page");
+}
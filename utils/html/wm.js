@@ -0,0 +1,55 @@
+// Config Portal script, served gzipped as /wm.js. Loaded at the end of the page
+
+function udVal(key, val) {
+  var request = new XMLHttpRequest();
+  var url = '/?key=' + key + '&value=' + encodeURIComponent(val);
+
+  request.open('GET', url, false);
+  request.send(null);
+}
+
+// Send every field, Credentials, Board Name, Dynamic Parameters and static IP alike
+function sv() {
+  var fields = document.querySelectorAll('input[id],select[id]');
+
+  for (var i = 0; i < fields.length; i++) {
+    udVal(fields[i].id, fields[i].value);
+  }
+
+  alert('Updated');
+}
+
+// Fill the shared SSID <datalist>, or both SSID <select>, from /scan
+(function () {
+  var lists = [];
+
+  ['SSIDs', 'id', 'id1'].forEach(function (id) {
+    var list = document.getElementById(id);
+
+    if (list && list.tagName != 'INPUT') {
+      lists.push(list);
+    }
+  });
+
+  if (lists.length == 0) {
+    return;
+  }
+
+  var request = new XMLHttpRequest();
+
+  request.onload = function () {
+    request.responseText.split('\n').forEach(function (ssid) {
+      if (ssid) {
+        lists.forEach(function (list) {
+          var option = document.createElement('option');
+
+          option.value = option.text = ssid;
+          list.appendChild(option);
+        });
+      }
+    });
+  };
+
+  request.open('GET', '/scan', true);
+  request.send();
+})();
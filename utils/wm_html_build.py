@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+#
+# wm_html_build.py
+#
+# Build step for the WiFiManager_NINA_Lite Config Portal page. Minifies the sources in utils/html, then writes
+# src/WiFiManager_NINA_Lite_HTML.h, shared by all boards :
+#   - the page fragments of wm_portal.html as const char[], with whitespace between tags removed
+#   - wm.css and wm.js, minified and gzipped, as PROGMEM byte arrays served with Content-Encoding: gzip.
+#     Their URLs carry a CRC of the content, so that browsers can cache them for good
+#
+# Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+# Licensed under MIT license
+#
+# Examples
+#   python3 wm_html_build.py                 Rebuild src/WiFiManager_NINA_Lite_HTML.h, and report the sizes
+#   python3 wm_html_build.py --css my.css    Print my.css minified as a C string, for setCustomsStyle()
+
+import argparse
+import gzip
+import os
+import re
+import sys
+import zlib
+
+HERE    = os.path.dirname(os.path.abspath(__file__))
+SOURCES = os.path.join(HERE, 'html')
+HEADER  = os.path.join(HERE, '..', 'src', 'WiFiManager_NINA_Lite_HTML.h')
+
+BANNER  = '''/*********************************************************************************************************************************
+  WiFiManager_NINA_Lite_HTML.h
+  For Mega, Teensy, SAM DUE, SAMD, STM32, nRF52 and RP2040 boards using WiFiNINA modules/shields
+
+  WiFiManager_NINA_WM_Lite is a library for the Mega, Teensy, SAM DUE, SAMD and STM32 boards
+  (https://github.com/khoih-prog/WiFiManager_NINA_Lite) to enable store Credentials in EEPROM/LittleFS for easy
+  configuration/reconfiguration and autoconnect/autoreconnect of WiFi and other services without Hardcoding.
+
+  Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+  Licensed under MIT license
+  Version: 1.5.0
+
+  Config Portal page fragments, style and script, shared by all boards.
+  GENERATED by utils/wm_html_build.py from utils/html. Edit the sources there, then run the script again.
+  **********************************************************************************************************************************/
+'''
+
+
+def minify_css(text):
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'\s+', ' ', text)
+    text = re.sub(r'\s*([{}:;,])\s*', r'\1', text)
+
+    return text.replace(';}', '}').strip()
+
+
+# Removes full-line // comments and whitespace outside strings. Statements must end with ';'
+def minify_js(text):
+    text  = '\n'.join(line for line in text.splitlines() if not line.strip().startswith('//'))
+    out   = []
+    quote = None
+    space = False
+    i     = 0
+
+    while i < len(text):
+        c = text[i]
+
+        if quote:
+            out.append(c)
+
+            if c == '\\':
+                out.append(text[i + 1])
+                i += 1
+            elif c == quote:
+                quote = None
+        elif c.isspace():
+            space = True
+        else:
+            # Keep one space only between two identifier chars, as in 'var x' or 'return x'
+            if space and out and is_word(out[-1]) and is_word(c):
+                out.append(' ')
+
+            space = False
+            out.append(c)
+
+            if c in '\'"':
+                quote = c
+
+        i += 1
+
+    return ''.join(out)
+
+
+def is_word(c):
+    return c.isalnum() or c in '_$'
+
+
+def html_fragments(text):
+    fragments = []
+
+    for match in re.finditer(r'<!--@(\w+)-->(.*?)(?=<!--@|\Z)', text, flags=re.S):
+        lines = [line.strip() for line in match.group(2).strip().splitlines()]
+        fragments.append((match.group(1), ''.join(lines)))
+
+    return fragments
+
+
+def c_string(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def c_bytes(data):
+    rows = []
+
+    for i in range(0, len(data), 16):
+        rows.append('  ' + ', '.join('0x%02X' % b for b in data[i:i + 16]))
+
+    return ',\n'.join(rows)
+
+
+def read(name):
+    with open(os.path.join(SOURCES, name), encoding='utf-8') as f:
+        return f.read()
+
+
+def build():
+    report  = []
+    out     = [BANNER, '#ifndef WiFiManager_NINA_Lite_HTML_h', '#define WiFiManager_NINA_Lite_HTML_h', '']
+
+    assets  = []
+
+    for name, minify, content_type in (('wm.css', minify_css, 'text/css'), ('wm.js', minify_js, 'application/javascript')):
+        source  = read(name)
+        mini    = minify(source).encode('utf-8')
+        packed  = gzip.compress(mini, 9, mtime=0)
+        url     = '/%s?v=%08x' % (name, zlib.crc32(mini))
+
+        assets.append((name, content_type, url, packed))
+        report.append('%-16s %6d source %6d minified %6d gzip' % (name, len(source.encode('utf-8')), len(mini), len(packed)))
+
+    css, js = assets
+
+    out.append('// Style and script, linked by URL. Served by the board with the gzip bytes below')
+    out.append('const char WIFININA_HTML_HEAD_STYLE[] /*PROGMEM*/ = %s;' % c_string("<link rel='stylesheet' href='%s'>" % css[2]))
+    out.append('const char WIFININA_HTML_SCRIPT[]     /*PROGMEM*/ = %s;' % c_string("<script src='%s'></script>" % js[2]))
+    out.append('')
+
+    source    = read('wm_portal.html')
+    total     = 0
+
+    for name, text in html_fragments(source):
+        out.append('const char %-28s /*PROGMEM*/ = %s;' % (name + '[]', c_string(text)))
+        total += len(text)
+
+    out.append('')
+    report.append('%-16s %6d source %6d minified' % ('wm_portal.html', len(source.encode('utf-8')), total))
+
+    for name, content_type, url, packed in assets:
+        symbol = 'WIFININA_' + name.replace('wm.', '').upper()
+
+        out.append('#define %-34s "%s"' % (symbol + '_PATH', '/' + name))
+        out.append('#define %-34s "%s"' % (symbol + '_TYPE', content_type))
+        out.append('')
+        out.append('const uint8_t %s_GZ[] PROGMEM =\n{\n%s\n};' % (symbol, c_bytes(packed)))
+        out.append('')
+
+    out.append('#endif    // WiFiManager_NINA_Lite_HTML_h')
+
+    with open(HEADER, 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(out) + '\n')
+
+    print('Written ' + os.path.normpath(HEADER))
+    print('\n'.join(report))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build WiFiManager_NINA_Lite Config Portal page header')
+    parser.add_argument('--css', help='only print this CSS file minified as a C string, e.g. for setCustomsStyle()')
+    args = parser.parse_args()
+
+    if args.css:
+        with open(args.css, encoding='utf-8') as f:
+            print(c_string('<style>' + minify_css(f.read()) + '</style>'))
+    else:
+        build()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
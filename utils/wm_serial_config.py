@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+#
+# wm_serial_config.py
+#
+# Host side of the WiFiManager_NINA_Lite Serial Config protocol (USE_SERIAL_CONFIG), to read and write the
+# whole Config image (Config Data, Dynamic Parameters and forced CP flag) of a board over its serial port.
+#
+# Built by Khoi Hoang https://github.com/khoih-prog/WiFiManager_NINA_Lite
+# Licensed under MIT license
+#
+# Requires pyserial : pip install pyserial
+#
+# Examples
+#   python3 wm_serial_config.py /dev/ttyACM0 read golden.bin
+#   python3 wm_serial_config.py /dev/ttyACM0 write golden.bin --cp none --reset
+#   python3 wm_serial_config.py /dev/ttyACM0 reset
+#
+# Frame : SOF(0xA5) TYPE(1) LENGTH(2, LE) PAYLOAD(LENGTH) CRC32(4, LE) of TYPE, LENGTH and PAYLOAD
+# Image : magic "WMSC"(4, LE) length(2, LE) forcedCP(1) reserved(1), then the image data as stored by the board
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+SOF         = 0xA5
+MAGIC       = 0x574D5343
+HEADER      = struct.Struct('<IHBB')
+
+READ        = 0x01
+WRITE       = 0x02
+RESET       = 0x03
+IMAGE       = 0x81
+STATUS      = 0x82
+
+STATUS_TEXT = { 0: 'OK', 1: 'image of another sketch or layout', 2: 'bad CRC', 3: 'unknown request' }
+CP_MODES    = { 'none': 0, 'once': 1, 'persistent': 2 }
+
+MAX_LENGTH  = 8192
+
+
+def frame(frame_type, payload=b''):
+    body = struct.pack('<BH', frame_type, len(payload)) + payload
+    return bytes([SOF]) + body + struct.pack('<I', zlib.crc32(body))
+
+
+class SerialConfig:
+
+    def __init__(self, port, timeout=2.0):
+        self.port     = port
+        self.timeout  = timeout
+        self.pending  = bytearray()
+
+    def request(self, frame_type, payload=b''):
+        self.port.write(frame(frame_type, payload))
+        self.port.flush()
+        return self.reply()
+
+    # Skip debug output and anything else until a frame with valid CRC
+    def reply(self):
+        deadline = time.monotonic() + self.timeout
+
+        while time.monotonic() < deadline:
+            start = self.pending.find(SOF)
+
+            if start < 0:
+                self.pending.clear()
+            else:
+                del self.pending[:start]
+
+                if len(self.pending) >= 4:
+                    frame_type, length = struct.unpack_from('<BH', self.pending, 1)
+
+                    if frame_type not in (IMAGE, STATUS) or length > MAX_LENGTH:
+                        del self.pending[0]
+                        continue
+
+                    if len(self.pending) >= length + 8:
+                        body  = bytes(self.pending[1:length + 4])
+                        crc,  = struct.unpack_from('<I', self.pending, length + 4)
+
+                        if crc == zlib.crc32(body):
+                            del self.pending[:length + 8]
+                            return frame_type, body[3:]
+
+                        del self.pending[0]
+                        continue
+
+            self.pending += self.port.read(max(1, self.port.in_waiting))
+
+        raise TimeoutError('No reply from board')
+
+    def read_image(self):
+        frame_type, payload = self.request(READ)
+
+        if frame_type != IMAGE:
+            raise RuntimeError('Read failed : ' + STATUS_TEXT.get(payload[0], 'error'))
+
+        return payload
+
+    def write_image(self, image, forced_cp=None):
+        magic, length, cp, reserved = HEADER.unpack_from(image)
+
+        if magic != MAGIC or length != len(image) - HEADER.size:
+            raise ValueError('Not a Config image')
+
+        if forced_cp is not None:
+            image = HEADER.pack(magic, length, forced_cp, reserved) + image[HEADER.size:]
+
+        self.check(self.request(WRITE, image))
+
+    def reset(self):
+        self.check(self.request(RESET))
+
+    @staticmethod
+    def check(reply):
+        frame_type, payload = reply
+
+        if frame_type != STATUS or payload[0] != 0:
+            raise RuntimeError('Board replied : ' + STATUS_TEXT.get(payload[0], 'error'))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Read / write WiFiManager_NINA_Lite Config image over serial')
+    parser.add_argument('port')
+    parser.add_argument('command', choices=['read', 'write', 'reset'])
+    parser.add_argument('file', nargs='?')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--cp', choices=CP_MODES.keys(), help='forced Config Portal flag to write, default as in file')
+    parser.add_argument('--reset', action='store_true', help='reset the board after write')
+    args = parser.parse_args()
+
+    import serial
+
+    board = SerialConfig(serial.Serial(args.port, args.baud, timeout=0.05))
+    start = time.monotonic()
+
+    if args.command == 'read':
+        image = board.read_image()
+
+        if args.file:
+            with open(args.file, 'wb') as f:
+                f.write(image)
+
+        magic, length, cp, reserved = HEADER.unpack_from(image)
+        print('Read %d bytes, forced CP %d' % (len(image), cp))
+
+    elif args.command == 'write':
+        if not args.file:
+            parser.error('write needs an image file')
+
+        with open(args.file, 'rb') as f:
+            board.write_image(f.read(), CP_MODES.get(args.cp))
+
+        if args.reset:
+            board.reset()
+
+        print('Written')
+
+    else:
+        board.reset()
+        print('Reset')
+
+    print('Done in %.3f s' % (time.monotonic() - start))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except (RuntimeError, ValueError, TimeoutError) as e:
+        sys.exit(str(e))